@@ -0,0 +1,342 @@
+// Frame loop macro-benchmark
+//
+// Models the way a game drives igasync: a ThreadPool services animation,
+// physics and streaming TaskLists, the main thread fans work out every frame,
+// joins it with a PromiseCombiner and drains its own TaskList while it waits,
+// then spends whatever is left of the frame budget on main-thread completions
+// from background streaming.
+//
+// Reports frame time percentiles, worker utilization and missed deadlines.
+// Pass --baseline to also run the same workload on std::async / std::thread.
+//
+// Usage: igasync_frame_sim [--frames=600] [--workers=4] [--animation_tasks=64]
+//          [--physics_tasks=32] [--task_us=50] [--streaming_tasks=4]
+//          [--streaming_us=2000] [--budget_ms=16.6] [--json] [--baseline]
+
+#include <igasync/promise_combiner.h>
+#include <igasync/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+  int Frames = 600;
+  int Workers = 4;
+  int AnimationTasks = 64;
+  int PhysicsTasks = 32;
+  int TaskMicros = 50;
+  int StreamingTasks = 4;
+  int StreamingMicros = 2000;
+  double BudgetMs = 1000. / 60.;
+  bool Json = false;
+  bool Baseline = false;
+};
+
+struct RunStats {
+  std::string Name;
+  std::vector<double> FrameMs;
+  int MissedDeadlines = 0;
+  double WorkerUtilization = 0.;
+  int64_t StreamingCompleted = 0;
+};
+
+bool parse_flag(const char* arg, const char* name, std::string& value) {
+  size_t name_len = std::strlen(name);
+  if (std::strncmp(arg, name, name_len) != 0) return false;
+  if (arg[name_len] == '\0') {
+    value = "";
+    return true;
+  }
+  if (arg[name_len] != '=') return false;
+  value = arg + name_len + 1;
+  return true;
+}
+
+Config parse_config(int argc, char** argv) {
+  Config config;
+  for (int i = 1; i < argc; i++) {
+    std::string v;
+    if (parse_flag(argv[i], "--frames", v)) {
+      config.Frames = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--workers", v)) {
+      config.Workers = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--animation_tasks", v)) {
+      config.AnimationTasks = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--physics_tasks", v)) {
+      config.PhysicsTasks = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--task_us", v)) {
+      config.TaskMicros = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--streaming_tasks", v)) {
+      config.StreamingTasks = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--streaming_us", v)) {
+      config.StreamingMicros = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--budget_ms", v)) {
+      config.BudgetMs = std::atof(v.c_str());
+    } else if (parse_flag(argv[i], "--json", v)) {
+      config.Json = true;
+    } else if (parse_flag(argv[i], "--baseline", v)) {
+      config.Baseline = true;
+    } else {
+      std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+      std::exit(1);
+    }
+  }
+  return config;
+}
+
+// Stand-in for real work - spins so that the simulation is CPU bound the way
+// animation/physics jobs are, and tracks busy time for utilization numbers.
+std::atomic_int64_t g_busy_ns = 0;
+
+void simulate_work(int micros) {
+  auto start = Clock::now();
+  auto end = start + std::chrono::microseconds(micros);
+  while (Clock::now() < end)
+    ;
+  g_busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   Clock::now() - start)
+                   .count();
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0.;
+  std::sort(values.begin(), values.end());
+  size_t idx = (size_t)(p * (values.size() - 1) + 0.5);
+  return values[std::min(idx, values.size() - 1)];
+}
+
+std::shared_ptr<igasync::Promise<void>> fan_out(
+    int task_count, int task_micros,
+    std::shared_ptr<igasync::TaskList> task_list) {
+  auto combiner = igasync::PromiseCombiner::Create();
+  for (int i = 0; i < task_count; i++) {
+    combiner->add(task_list->run([task_micros]() { simulate_work(task_micros); }),
+                  task_list);
+  }
+  return combiner->combine([](igasync::PromiseCombiner::Result) {}, task_list);
+}
+
+RunStats run_igasync(const Config& config) {
+  RunStats stats;
+  stats.Name = "igasync";
+
+  igasync::ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = config.Workers;
+  auto thread_pool = igasync::ThreadPool::Create(desc);
+
+  auto main_thread_list = igasync::TaskList::Create();
+  auto animation_list = igasync::TaskList::Create();
+  auto physics_list = igasync::TaskList::Create();
+  auto streaming_list = igasync::TaskList::Create();
+  thread_pool->add_task_list(animation_list);
+  thread_pool->add_task_list(physics_list);
+  thread_pool->add_task_list(streaming_list);
+
+  // Background streaming keeps a fixed number of loads in flight, and hands
+  // each result back to the main thread
+  std::atomic_bool is_streaming = true;
+  std::atomic_int64_t streaming_completed = 0;
+  std::function<void()> start_streaming_load;
+  start_streaming_load = [&]() {
+    if (!is_streaming) return;
+    streaming_list
+        ->run([&config]() { simulate_work(config.StreamingMicros); })
+        ->on_resolve(
+            [&]() {
+              streaming_completed++;
+              simulate_work(config.TaskMicros / 4);
+              start_streaming_load();
+            },
+            main_thread_list);
+  };
+  for (int i = 0; i < config.StreamingTasks; i++) {
+    start_streaming_load();
+  }
+
+  g_busy_ns = 0;
+  auto run_start = Clock::now();
+  auto budget = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(config.BudgetMs));
+
+  for (int frame = 0; frame < config.Frames; frame++) {
+    auto frame_start = Clock::now();
+    auto deadline = frame_start + budget;
+
+    auto frame_combiner = igasync::PromiseCombiner::Create();
+    frame_combiner->add(
+        fan_out(config.AnimationTasks, config.TaskMicros, animation_list),
+        main_thread_list);
+    frame_combiner->add(
+        fan_out(config.PhysicsTasks, config.TaskMicros, physics_list),
+        main_thread_list);
+
+    bool is_frame_done = false;
+    frame_combiner->combine(
+        [&is_frame_done](igasync::PromiseCombiner::Result) {
+          is_frame_done = true;
+        },
+        main_thread_list);
+
+    // Schedule/execute_until instead of fork/join - the main thread helps out
+    while (!is_frame_done) {
+      if (!main_thread_list->execute_next() &&
+          !animation_list->execute_next() && !physics_list->execute_next()) {
+        std::this_thread::yield();
+      }
+    }
+
+    auto frame_end = Clock::now();
+    double frame_ms =
+        std::chrono::duration<double, std::milli>(frame_end - frame_start)
+            .count();
+    stats.FrameMs.push_back(frame_ms);
+    if (frame_end > deadline) {
+      stats.MissedDeadlines++;
+    }
+
+    // Spend the rest of the budget on streaming completions, then wait for
+    // "vsync"
+    while (Clock::now() < deadline && main_thread_list->execute_next())
+      ;
+    std::this_thread::sleep_until(deadline);
+  }
+
+  auto run_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - run_start)
+                    .count();
+  is_streaming = false;
+
+  // Main thread work counts against utilization too, it shares the CPU
+  stats.WorkerUtilization =
+      (double)g_busy_ns / ((double)run_ns * (config.Workers + 1));
+  stats.StreamingCompleted = streaming_completed;
+
+  // Let in-flight streaming loads land before tearing down
+  while (main_thread_list->execute_next() || streaming_list->execute_next())
+    ;
+  thread_pool->clear_all_task_lists();
+  return stats;
+}
+
+RunStats run_baseline(const Config& config) {
+  RunStats stats;
+  stats.Name = "std::async";
+
+  std::atomic_bool is_streaming = true;
+  std::atomic_int64_t streaming_completed = 0;
+  std::vector<std::thread> streaming_threads;
+  for (int i = 0; i < config.StreamingTasks; i++) {
+    streaming_threads.emplace_back([&]() {
+      while (is_streaming) {
+        simulate_work(config.StreamingMicros);
+        streaming_completed++;
+      }
+    });
+  }
+
+  g_busy_ns = 0;
+  auto run_start = Clock::now();
+  auto budget = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(config.BudgetMs));
+
+  for (int frame = 0; frame < config.Frames; frame++) {
+    auto frame_start = Clock::now();
+    auto deadline = frame_start + budget;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(config.AnimationTasks + config.PhysicsTasks);
+    for (int i = 0; i < config.AnimationTasks + config.PhysicsTasks; i++) {
+      futures.push_back(std::async(std::launch::async, [&config]() {
+        simulate_work(config.TaskMicros);
+      }));
+    }
+    for (auto& f : futures) {
+      f.wait();
+    }
+
+    auto frame_end = Clock::now();
+    stats.FrameMs.push_back(
+        std::chrono::duration<double, std::milli>(frame_end - frame_start)
+            .count());
+    if (frame_end > deadline) {
+      stats.MissedDeadlines++;
+    }
+    std::this_thread::sleep_until(deadline);
+  }
+
+  auto run_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - run_start)
+                    .count();
+  is_streaming = false;
+  for (auto& t : streaming_threads) {
+    t.join();
+  }
+
+  stats.WorkerUtilization =
+      (double)g_busy_ns / ((double)run_ns * (config.Workers + 1));
+  stats.StreamingCompleted = streaming_completed;
+  return stats;
+}
+
+void print_stats(const Config& config, const std::vector<RunStats>& runs) {
+  if (config.Json) {
+    std::printf("{\n  \"config\": {\"frames\": %d, \"workers\": %d, "
+                "\"animation_tasks\": %d, \"physics_tasks\": %d, "
+                "\"task_us\": %d, \"streaming_tasks\": %d, "
+                "\"streaming_us\": %d, \"budget_ms\": %.3f},\n  \"runs\": [\n",
+                config.Frames, config.Workers, config.AnimationTasks,
+                config.PhysicsTasks, config.TaskMicros, config.StreamingTasks,
+                config.StreamingMicros, config.BudgetMs);
+    for (size_t i = 0; i < runs.size(); i++) {
+      const RunStats& r = runs[i];
+      std::printf(
+          "    {\"name\": \"%s\", \"p50_ms\": %.4f, \"p90_ms\": %.4f, "
+          "\"p99_ms\": %.4f, \"max_ms\": %.4f, \"missed_deadlines\": %d, "
+          "\"worker_utilization\": %.4f, \"streaming_completed\": %lld}%s\n",
+          r.Name.c_str(), percentile(r.FrameMs, 0.5),
+          percentile(r.FrameMs, 0.9), percentile(r.FrameMs, 0.99),
+          percentile(r.FrameMs, 1.), r.MissedDeadlines, r.WorkerUtilization,
+          (long long)r.StreamingCompleted, i + 1 < runs.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+    return;
+  }
+
+  std::printf("%-12s %9s %9s %9s %9s %8s %8s %10s\n", "runtime", "p50 ms",
+              "p90 ms", "p99 ms", "max ms", "missed", "util", "streamed");
+  for (const RunStats& r : runs) {
+    std::printf("%-12s %9.3f %9.3f %9.3f %9.3f %8d %7.1f%% %10lld\n",
+                r.Name.c_str(), percentile(r.FrameMs, 0.5),
+                percentile(r.FrameMs, 0.9), percentile(r.FrameMs, 0.99),
+                percentile(r.FrameMs, 1.), r.MissedDeadlines,
+                r.WorkerUtilization * 100., (long long)r.StreamingCompleted);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config config = parse_config(argc, argv);
+
+  std::vector<RunStats> runs;
+  runs.push_back(run_igasync(config));
+  if (config.Baseline) {
+    runs.push_back(run_baseline(config));
+  }
+
+  print_stats(config, runs);
+  return 0;
+}
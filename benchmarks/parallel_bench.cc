@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+#include <igasync/parallel.h>
+#include <igasync/thread_pool.h>
+
+#include <numeric>
+#include <vector>
+
+using namespace igasync;
+
+namespace {
+struct BenchPool {
+  BenchPool()
+      : thread_pool(ThreadPool::Create()), task_list(TaskList::Create()) {
+    thread_pool->add_task_list(task_list);
+  }
+
+  std::shared_ptr<ThreadPool> thread_pool;
+  std::shared_ptr<TaskList> task_list;
+};
+
+BenchPool& bench_pool() {
+  static BenchPool pool;
+  return pool;
+}
+
+template <typename T>
+void wait_for(const std::shared_ptr<Promise<T>>& p) {
+  while (!p->is_finished())
+    ;
+}
+
+std::vector<double> make_data(size_t size) {
+  std::vector<double> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = (double)(i % 97) * 0.25;
+  }
+  return data;
+}
+}  // namespace
+
+static void BM_SerialReduce(benchmark::State& state) {
+  auto data = ::make_data(state.range(0));
+  for (auto _ : state) {
+    double sum = std::accumulate(data.begin(), data.end(), 0.);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerialReduce)->Range(1 << 10, 1 << 22);
+
+static void BM_ParallelReduce(benchmark::State& state) {
+  auto& pool = ::bench_pool();
+  auto data = ::make_data(state.range(0));
+
+  ParallelDesc desc;
+  desc.Deterministic = state.range(1) != 0;
+
+  for (auto _ : state) {
+    auto p = parallel_reduce(
+        size_t{0}, data.size(), 0.,
+        [&data](double& acc, size_t i) { acc += data[i]; },
+        [](double& acc, double partial) { acc += partial; }, pool.task_list,
+        desc);
+    ::wait_for(p);
+    benchmark::DoNotOptimize(p->unsafe_sync_peek());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelReduce)
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 22, 16), {0, 1}})
+    ->UseRealTime();
+
+static void BM_SerialInclusiveScan(benchmark::State& state) {
+  auto data = ::make_data(state.range(0));
+  std::vector<double> out(data.size());
+  for (auto _ : state) {
+    std::inclusive_scan(data.begin(), data.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerialInclusiveScan)->Range(1 << 10, 1 << 22);
+
+static void BM_ParallelInclusiveScan(benchmark::State& state) {
+  auto& pool = ::bench_pool();
+  auto data = ::make_data(state.range(0));
+  std::vector<double> out(data.size());
+
+  for (auto _ : state) {
+    auto p = parallel_inclusive_scan(
+        data.begin(), data.end(), out.begin(), 0.,
+        [](const double& a, const double& b) { return a + b; },
+        pool.task_list);
+    ::wait_for(p);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelInclusiveScan)->Range(1 << 10, 1 << 22)->UseRealTime();
+
+static void BM_ParallelFor(benchmark::State& state) {
+  auto& pool = ::bench_pool();
+  std::vector<double> data = ::make_data(state.range(0));
+
+  for (auto _ : state) {
+    auto p = parallel_for(
+        size_t{0}, data.size(), [&data](size_t i) { data[i] *= 1.0001; },
+        pool.task_list);
+    ::wait_for(p);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelFor)->Range(1 << 10, 1 << 20)->UseRealTime();
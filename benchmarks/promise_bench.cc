@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <igasync/promise.h>
+#include <igasync/task_list.h>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(const std::shared_ptr<TaskList>& tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+static void BM_PromiseCreateResolve(benchmark::State& state) {
+  for (auto _ : state) {
+    auto p = Promise<int>::Create();
+    p->resolve(1);
+    benchmark::DoNotOptimize(p);
+  }
+}
+BENCHMARK(BM_PromiseCreateResolve);
+
+// Time from resolving the head of a chain of N thens to the tail resolving
+static void BM_PromiseThenChain(benchmark::State& state) {
+  auto tl = TaskList::Create();
+  const int64_t chain_length = state.range(0);
+
+  for (auto _ : state) {
+    auto head = Promise<int>::Create();
+    auto tail = head;
+    for (int64_t i = 0; i < chain_length; i++) {
+      tail = tail->then([](const int& v) { return v + 1; }, tl);
+    }
+
+    head->resolve(0);
+    ::flush_task_list(tl);
+    benchmark::DoNotOptimize(tail->unsafe_sync_peek());
+  }
+  state.SetItemsProcessed(state.iterations() * chain_length);
+}
+BENCHMARK(BM_PromiseThenChain)->Arg(1)->Arg(16)->Arg(256);
+
+static void BM_PromiseFanOut(benchmark::State& state) {
+  auto tl = TaskList::Create();
+  const int64_t fan_out = state.range(0);
+
+  for (auto _ : state) {
+    auto p = Promise<int>::Create();
+    int sum = 0;
+    for (int64_t i = 0; i < fan_out; i++) {
+      p->on_resolve([&sum](const int& v) { sum += v; }, tl);
+    }
+
+    p->resolve(1);
+    ::flush_task_list(tl);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * fan_out);
+}
+BENCHMARK(BM_PromiseFanOut)->Arg(1)->Arg(16)->Arg(256);
+
+static void BM_VoidPromiseFanOut(benchmark::State& state) {
+  auto tl = TaskList::Create();
+  const int64_t fan_out = state.range(0);
+
+  for (auto _ : state) {
+    auto p = Promise<void>::Create();
+    int ct = 0;
+    for (int64_t i = 0; i < fan_out; i++) {
+      p->on_resolve([&ct]() { ct++; }, tl);
+    }
+
+    p->resolve();
+    ::flush_task_list(tl);
+    benchmark::DoNotOptimize(ct);
+  }
+  state.SetItemsProcessed(state.iterations() * fan_out);
+}
+BENCHMARK(BM_VoidPromiseFanOut)->Arg(1)->Arg(16)->Arg(256);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <igasync/promise_combiner.h>
+#include <igasync/task_list.h>
+
+#include <vector>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(const std::shared_ptr<TaskList>& tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+static void BM_PromiseCombinerFanIn(benchmark::State& state) {
+  auto tl = TaskList::Create();
+  const int64_t fan_in = state.range(0);
+
+  std::vector<std::shared_ptr<Promise<int>>> inputs;
+  inputs.reserve(fan_in);
+
+  for (auto _ : state) {
+    inputs.clear();
+    auto combiner = PromiseCombiner::Create();
+    for (int64_t i = 0; i < fan_in; i++) {
+      inputs.push_back(Promise<int>::Create());
+      auto key = combiner->add(inputs.back(), tl);
+      benchmark::DoNotOptimize(key);
+    }
+
+    bool is_done = false;
+    combiner->combine([&is_done](PromiseCombiner::Result) { is_done = true; },
+                      tl);
+
+    for (auto& input : inputs) {
+      input->resolve(1);
+    }
+    ::flush_task_list(tl);
+    benchmark::DoNotOptimize(is_done);
+  }
+  state.SetItemsProcessed(state.iterations() * fan_in);
+}
+BENCHMARK(BM_PromiseCombinerFanIn)->Arg(2)->Arg(16)->Arg(128)->Arg(1024);
@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <igasync/task.h>
+
+using namespace igasync;
+
+namespace {
+void noop() {}
+}  // namespace
+
+static void BM_TaskOf(benchmark::State& state) {
+  for (auto _ : state) {
+    auto task = Task::Of(::noop);
+    benchmark::DoNotOptimize(task);
+  }
+}
+BENCHMARK(BM_TaskOf);
+
+static void BM_TaskOfWithCapture(benchmark::State& state) {
+  auto shared = std::make_shared<int>(5);
+  for (auto _ : state) {
+    auto task = Task::Of([shared]() { benchmark::DoNotOptimize(*shared); });
+    benchmark::DoNotOptimize(task);
+  }
+}
+BENCHMARK(BM_TaskOfWithCapture);
+
+static void BM_TaskOfAndRun(benchmark::State& state) {
+  int ct = 0;
+  for (auto _ : state) {
+    auto task = Task::Of([&ct]() { ct++; });
+    task->run();
+  }
+  benchmark::DoNotOptimize(ct);
+}
+BENCHMARK(BM_TaskOfAndRun);
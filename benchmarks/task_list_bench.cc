@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <igasync/task_list.h>
+
+using namespace igasync;
+
+namespace {
+void noop() {}
+}  // namespace
+
+static void BM_TaskListScheduleExecute(benchmark::State& state) {
+  auto task_list = TaskList::Create();
+
+  for (auto _ : state) {
+    task_list->schedule(Task::Of(::noop));
+    task_list->execute_next();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaskListScheduleExecute);
+
+static void BM_TaskListBurst(benchmark::State& state) {
+  auto task_list = TaskList::Create();
+  const int64_t burst_size = state.range(0);
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < burst_size; i++) {
+      task_list->schedule(Task::Of(::noop));
+    }
+    while (task_list->execute_next())
+      ;
+  }
+  state.SetItemsProcessed(state.iterations() * burst_size);
+}
+BENCHMARK(BM_TaskListBurst)->Arg(16)->Arg(256)->Arg(4096);
+
+// Every benchmark thread both produces and consumes against the same list
+static void BM_TaskListMultiProducer(benchmark::State& state) {
+  static std::shared_ptr<TaskList> task_list;
+  if (state.thread_index() == 0) {
+    task_list = TaskList::Create();
+  }
+
+  for (auto _ : state) {
+    task_list->schedule(Task::Of(::noop));
+    task_list->execute_next();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    while (task_list->execute_next())
+      ;
+  }
+}
+BENCHMARK(BM_TaskListMultiProducer)->ThreadRange(1, 8)->UseRealTime();
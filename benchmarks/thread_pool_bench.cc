@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <igasync/thread_pool.h>
+
+#include <atomic>
+
+using namespace igasync;
+
+// Time from scheduling a task on an idle pool to a worker running it
+static void BM_ThreadPoolWakeupLatency(benchmark::State& state) {
+  ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = (int)state.range(0);
+  auto thread_pool = ThreadPool::Create(desc);
+  auto task_list = TaskList::Create();
+  thread_pool->add_task_list(task_list);
+
+  std::atomic_bool has_run = false;
+  for (auto _ : state) {
+    state.PauseTiming();
+    has_run = false;
+    // Give workers a chance to go back to sleep
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    state.ResumeTiming();
+
+    task_list->schedule(Task::Of([&has_run]() { has_run = true; }));
+    while (!has_run.load(std::memory_order_acquire))
+      ;
+  }
+}
+BENCHMARK(BM_ThreadPoolWakeupLatency)->Arg(1)->Arg(4)->UseRealTime();
+
+// Throughput of tiny tasks through a busy pool
+static void BM_ThreadPoolThroughput(benchmark::State& state) {
+  ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = (int)state.range(0);
+  auto thread_pool = ThreadPool::Create(desc);
+  auto task_list = TaskList::Create();
+  thread_pool->add_task_list(task_list);
+
+  const int64_t kBatchSize = 1024;
+  std::atomic_int64_t remaining = 0;
+  for (auto _ : state) {
+    remaining = kBatchSize;
+    for (int64_t i = 0; i < kBatchSize; i++) {
+      task_list->schedule(Task::Of([&remaining]() { remaining--; }));
+    }
+    while (remaining.load(std::memory_order_acquire) > 0)
+      ;
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_ThreadPoolThroughput)->Arg(1)->Arg(4)->UseRealTime();
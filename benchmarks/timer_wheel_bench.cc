@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <igasync/timer_wheel.h>
+
+#include <vector>
+
+using namespace igasync;
+
+namespace {
+void noop() {}
+
+TimerWheel::Desc pumped_desc() {
+  TimerWheel::Desc desc;
+  desc.UseDedicatedThread = false;
+  return desc;
+}
+}  // namespace
+
+// Typical timeout use - almost every timer is cancelled before it fires
+static void BM_TimerWheelScheduleCancel(benchmark::State& state) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+
+  for (auto _ : state) {
+    auto id =
+        wheel->schedule_after(std::chrono::seconds(5), Task::Of(::noop));
+    wheel->cancel(id);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelScheduleCancel);
+
+// Schedule many timers spread over a range of delays, then fire all of them
+static void BM_TimerWheelScheduleFire(benchmark::State& state) {
+  const int64_t timer_count = state.range(0);
+  auto wheel = TimerWheel::Create(::pumped_desc());
+
+  for (auto _ : state) {
+    auto now = TimerWheel::Clock::now();
+    for (int64_t i = 0; i < timer_count; i++) {
+      wheel->schedule_at(now + std::chrono::milliseconds(i % 60000),
+                         Task::Of(::noop));
+    }
+    wheel->advance(now + std::chrono::milliseconds(60001));
+  }
+  state.SetItemsProcessed(state.iterations() * timer_count);
+}
+BENCHMARK(BM_TimerWheelScheduleFire)->Arg(1024)->Arg(1 << 20);
+
+// Cost of cancelling out of a wheel that already holds many timers
+static void BM_TimerWheelCancelUnderLoad(benchmark::State& state) {
+  const int64_t timer_count = state.range(0);
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  for (int64_t i = 0; i < timer_count; i++) {
+    wheel->schedule_after(std::chrono::milliseconds(i), Task::Of(::noop));
+  }
+
+  for (auto _ : state) {
+    auto id =
+        wheel->schedule_after(std::chrono::milliseconds(250), Task::Of(::noop));
+    wheel->cancel(id);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelCancelUnderLoad)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,156 @@
+#ifndef IGASYNC_BLOCKING_POOL_H
+#define IGASYNC_BLOCKING_POOL_H
+
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+#include <igasync/task_label.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Elastic set of threads for calls that spend their time waiting
+ *        (blocking file reads, sockets, compression libraries, sleeps)
+ *        rather than computing.
+ *
+ * ThreadPool workers are sized to the core count, so every worker parked in a
+ * syscall is a core that compute TaskLists can not use. Blocking work belongs
+ * here instead: threads are started on demand, up to Desc::MaxThreads, and
+ * threads beyond Desc::MinThreads exit after sitting idle for
+ * Desc::IdleTimeout. Once MaxThreads calls are blocked, further tasks wait in
+ * a FIFO queue.
+ *
+ * BlockingPool is an ExecutionContext, so promise continuations that block
+ * can be sent here directly. run() resolves its result on a chosen execution
+ * context, so the code consuming the result never runs on a blocking thread.
+ *
+ * @code{.cc}
+ * auto blocking = BlockingPool::Create();
+ * blocking->run([]() { return decompress("level.pak"); }, compute_tasks)
+ *     ->then(parse_level, compute_tasks);
+ * @endcode
+ */
+class BlockingPool : public ExecutionContext {
+ public:
+  /**
+   * @brief Describes all parameters used to construct a BlockingPool, with
+   *        reasonable defaults.
+   */
+  struct Desc {
+    Desc() noexcept {}
+
+    /** Threads started up front, and kept alive while idle */
+    uint32_t MinThreads{0};
+
+    /** Most threads running at once - more tasks than this are queued */
+    uint32_t MaxThreads{64};
+
+    /** Threads beyond MinThreads exit after being idle for this long */
+    std::chrono::nanoseconds IdleTimeout{std::chrono::seconds(10)};
+
+    /** Prefix of thread names reported to the TraceRecorder */
+    std::string Name{"igasync blocking"};
+  };
+
+ public:
+  static std::shared_ptr<BlockingPool> Create(Desc desc = Desc());
+
+  /**
+   * @brief Process-wide pool with default parameters, used by run_blocking.
+   *        Created on first use.
+   */
+  static std::shared_ptr<BlockingPool> Default();
+
+  /**
+   * @brief Runs every queued task, then joins all threads
+   */
+  ~BlockingPool();
+
+  BlockingPool(const BlockingPool&) = delete;
+  BlockingPool(BlockingPool&&) = delete;
+  BlockingPool& operator=(const BlockingPool&) = delete;
+  BlockingPool& operator=(BlockingPool&&) = delete;
+
+  /**
+   * @brief Run a task on a blocking thread, starting a new thread if every
+   *        existing one is busy and the pool is not at Desc::MaxThreads
+   */
+  virtual void schedule(std::unique_ptr<Task> task) override;
+
+  /**
+   * @brief Invoke f on a blocking thread, and return a promise containing
+   *        the result
+   * @param completion_context Where the returned promise is resolved (and so
+   *        where continuations attached with on_resolve are scheduled from).
+   *        If null, it is resolved on the blocking thread.
+   */
+  template <typename F, typename RslT = std::invoke_result_t<F>>
+  auto run(F&& f,
+           std::shared_ptr<ExecutionContext> completion_context = nullptr,
+           TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
+
+  /**
+   * @return Number of threads currently started, busy or idle
+   */
+  size_t thread_count() const;
+
+  /**
+   * @return Number of started threads waiting for a task
+   */
+  size_t idle_thread_count() const;
+
+  /**
+   * @return Number of tasks waiting for a thread
+   */
+  size_t queued_task_count() const;
+
+ private:
+  BlockingPool(Desc desc);
+
+  /** Requires m_threads_ */
+  void start_thread();
+  void run_thread(uint32_t thread_idx);
+
+  /** Join threads that have exited since the last call */
+  void join_retired_threads();
+
+ private:
+  Desc desc_;
+
+  mutable std::mutex m_threads_;
+  std::condition_variable cv_has_task_;
+  std::condition_variable cv_thread_exited_;
+  std::deque<std::unique_ptr<Task>> tasks_;
+  std::list<std::thread> threads_;
+  std::vector<std::thread> retired_threads_;
+  size_t idle_thread_count_;
+  uint32_t next_thread_idx_;
+  bool is_stopping_;
+};
+
+/**
+ * @brief Invoke f on the process-wide BlockingPool::Default() pool
+ * @param completion_context Where the returned promise is resolved. If null,
+ *        it is resolved on the blocking thread.
+ */
+template <typename F, typename RslT = std::invoke_result_t<F>>
+auto run_blocking(
+    F&& f, std::shared_ptr<ExecutionContext> completion_context = nullptr,
+    TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
+
+}  // namespace igasync
+
+#include <igasync/blocking_pool.inl>
+
+#endif
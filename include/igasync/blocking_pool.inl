@@ -0,0 +1,49 @@
+#include <igasync/blocking_pool.h>
+
+namespace igasync {
+
+template <typename F, typename RslT>
+auto BlockingPool::run(F&& f,
+                       std::shared_ptr<ExecutionContext> completion_context,
+                       TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
+  auto promise = Promise<RslT>::Create(label.Location);
+
+  if constexpr (std::is_void_v<RslT>) {
+    schedule(Task::Labeled(
+        label, [promise, f = std::forward<F>(f),
+                completion_context = std::move(completion_context)]() mutable {
+          f();
+          if (completion_context == nullptr) {
+            promise->resolve();
+            return;
+          }
+          completion_context->schedule(
+              Task::Of([promise]() { promise->resolve(); }));
+        }));
+  } else {
+    schedule(Task::Labeled(
+        label, [promise, f = std::forward<F>(f),
+                completion_context = std::move(completion_context)]() mutable {
+          RslT rsl = f();
+          if (completion_context == nullptr) {
+            promise->resolve(std::move(rsl));
+            return;
+          }
+          completion_context->schedule(
+              Task::Of([promise, rsl = std::move(rsl)]() mutable {
+                promise->resolve(std::move(rsl));
+              }));
+        }));
+  }
+
+  return promise;
+}
+
+template <typename F, typename RslT>
+auto run_blocking(F&& f, std::shared_ptr<ExecutionContext> completion_context,
+                  TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
+  return BlockingPool::Default()->run(std::forward<F>(f),
+                                      std::move(completion_context), label);
+}
+
+}  // namespace igasync
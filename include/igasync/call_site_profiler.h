@@ -0,0 +1,119 @@
+#ifndef IGASYNC_CALL_SITE_PROFILER_H
+#define IGASYNC_CALL_SITE_PROFILER_H
+
+#include <igasync/metrics.h>
+#include <igasync/task_label.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Aggregated timings of every task produced by one call site
+ */
+struct CallSiteStats {
+  /** Name given to the task label, or nullptr if unnamed */
+  const char* Name{nullptr};
+
+  /** Source location of the call that scheduled the tasks (may be empty) */
+  const char* File{""};
+  const char* Function{""};
+  uint32_t Line{0};
+
+  uint64_t Count{0};
+
+  std::chrono::nanoseconds TotalRunTime{0};
+  std::chrono::nanoseconds RunTimeP50{0};
+  std::chrono::nanoseconds RunTimeP99{0};
+
+  std::chrono::nanoseconds TotalQueueWait{0};
+  std::chrono::nanoseconds QueueWaitP50{0};
+  std::chrono::nanoseconds QueueWaitP99{0};
+};
+
+/**
+ * @brief Process-wide profiler that attributes task run time and queue wait
+ *        to the call site that produced each task (see TaskLabel).
+ *
+ * Useful for finding the handful of continuations that eat a frame budget:
+ *
+ * @code{.cc}
+ * CallSiteProfiler::Get().start();
+ * run_some_frames();
+ * CallSiteProfiler::Get().stop();
+ * CallSiteProfiler::Get().write_report(std::cout);
+ * @endcode
+ *
+ * While stopped, tasks only pay for one relaxed atomic load.
+ */
+class CallSiteProfiler {
+ public:
+  static CallSiteProfiler& Get();
+
+  static bool is_enabled() {
+    return is_enabled_.load(std::memory_order_relaxed);
+  }
+
+  CallSiteProfiler(const CallSiteProfiler&) = delete;
+  CallSiteProfiler(CallSiteProfiler&&) = delete;
+  CallSiteProfiler& operator=(const CallSiteProfiler&) = delete;
+  CallSiteProfiler& operator=(CallSiteProfiler&&) = delete;
+
+  /**
+   * @brief Discard previously collected data and begin collecting
+   */
+  void start();
+  void stop();
+
+  void record(const TaskLabel& label, std::chrono::nanoseconds queue_wait,
+              std::chrono::nanoseconds run_time);
+
+  /**
+   * @return Stats for every call site seen, most total run time first
+   */
+  std::vector<CallSiteStats> snapshot() const;
+
+  /**
+   * @brief Write a human-readable table of the most expensive call sites
+   */
+  void write_report(std::ostream& out, size_t max_rows = 20) const;
+
+ private:
+  CallSiteProfiler() = default;
+
+  struct SiteKey {
+    const char* Name;
+    const char* File;
+    uint32_t Line;
+    uint32_t Column;
+
+    bool operator==(const SiteKey& o) const = default;
+  };
+
+  struct SiteKeyHash {
+    size_t operator()(const SiteKey& key) const;
+  };
+
+  struct Site {
+    TaskLabel Label;
+    LatencyHistogram QueueWait;
+    LatencyHistogram RunTime;
+  };
+
+ private:
+  static std::atomic_bool is_enabled_;
+
+  mutable std::shared_mutex m_sites_;
+  std::unordered_map<SiteKey, std::unique_ptr<Site>, SiteKeyHash> sites_;
+};
+
+}  // namespace igasync
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef IGASYNC_DEPENDENCY_RECORDER_H
+#define IGASYNC_DEPENDENCY_RECORDER_H
+
+#include <igasync/task_label.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace igasync {
+
+template <class ValT>
+class Promise;
+
+/**
+ * @brief One recorded promise resolution
+ */
+struct PromiseNode {
+  const void* Promise{nullptr};
+
+  /**
+   * @brief Promise whose continuation resolved this one, or nullptr if it was
+   *        resolved outside of a promise continuation (e.g. by the main loop)
+   */
+  const void* Predecessor{nullptr};
+
+  /** Label of the task that resolved the promise (empty if none) */
+  TaskLabel ProducerLabel{nullptr, std::source_location()};
+
+  std::chrono::high_resolution_clock::time_point ResolvedAt{};
+
+  /** Time the producing task waited between being scheduled and starting */
+  std::chrono::nanoseconds QueueWait{0};
+
+  /** Time the producing task ran before resolving the promise */
+  std::chrono::nanoseconds RunTime{0};
+};
+
+/**
+ * @brief Opt-in recorder of which promise's continuation resolved which
+ *        promise, used to find the critical path through a promise graph.
+ *
+ * A promise is always resolved by at most one continuation, so following the
+ * recorded predecessors back from any promise gives the chain of resolutions
+ * that actually determined when it finished. For a PromiseCombiner, the
+ * predecessor of the combined promise is the straggler - the input that
+ * resolved last.
+ *
+ * @code{.cc}
+ * DependencyRecorder::Get().start();
+ * auto frame_done = build_frame();
+ * // ... once frame_done resolves:
+ * DependencyRecorder::Get().stop();
+ * DependencyRecorder::Get().write_report(std::cout, frame_done.get());
+ * @endcode
+ *
+ * Recording takes a global lock on every promise resolution, so only enable
+ * it while investigating. Promises are identified by address - if a promise
+ * is destroyed and its memory reused while recording, the new promise
+ * replaces it in the graph.
+ */
+class DependencyRecorder {
+ public:
+  static DependencyRecorder& Get();
+
+  static bool is_recording() {
+    return is_recording_.load(std::memory_order_relaxed);
+  }
+
+  DependencyRecorder(const DependencyRecorder&) = delete;
+  DependencyRecorder(DependencyRecorder&&) = delete;
+  DependencyRecorder& operator=(const DependencyRecorder&) = delete;
+  DependencyRecorder& operator=(DependencyRecorder&&) = delete;
+
+  /**
+   * @brief Discard recorded resolutions and start recording
+   * @param max_nodes Recording silently stops growing after this many
+   *                  resolutions
+   */
+  void start(size_t max_nodes = 1 << 20);
+  void stop();
+
+  /**
+   * @brief Called by promises as they resolve, on the resolving thread
+   */
+  void on_promise_resolved(const void* promise);
+
+  /**
+   * @return The chain of resolutions that ended in the given promise, oldest
+   *         first. Empty if the promise has not resolved while recording.
+   */
+  std::vector<PromiseNode> critical_path(const void* promise) const;
+
+  template <class ValT>
+  std::vector<PromiseNode> critical_path(
+      const std::shared_ptr<Promise<ValT>>& promise) const {
+    return critical_path(static_cast<const void*>(promise.get()));
+  }
+
+  /**
+   * @brief Write the critical path ending at a promise, with the queue wait,
+   *        run time and total delay contributed by each step
+   */
+  void write_report(std::ostream& out, const void* promise) const;
+
+  size_t node_count() const;
+
+ private:
+  DependencyRecorder() = default;
+
+ private:
+  static std::atomic_bool is_recording_;
+
+  mutable std::mutex m_nodes_;
+  size_t max_nodes_{0};
+  std::vector<PromiseNode> nodes_;
+  std::unordered_map<const void*, size_t> latest_node_;
+};
+
+}  // namespace igasync
+
+#endif
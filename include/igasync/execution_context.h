@@ -3,6 +3,9 @@
 
 #include <igasync/task.h>
 
+#include <memory>
+#include <vector>
+
 namespace igasync {
 
 /**
@@ -15,8 +18,37 @@ namespace igasync {
 class ExecutionContext {
  public:
   virtual void schedule(std::unique_ptr<Task> task) = 0;
+
+  /**
+   * @brief Schedule several tasks at once, in order. Contexts that can hand
+   *        over a batch more cheaply than one task at a time (e.g. with a
+   *        single queue operation and wakeup) override this.
+   */
+  virtual void schedule_bulk(std::vector<std::unique_ptr<Task>> tasks) {
+    for (auto& task : tasks) {
+      schedule(std::move(task));
+    }
+  }
+};
+
+/**
+ * @brief Task bound for an execution context, see schedule_grouped
+ */
+struct ContextTask {
+  std::shared_ptr<ExecutionContext> Context;
+  std::unique_ptr<Task> Run;
 };
 
+/**
+ * @brief Schedule each task on its execution context, with one schedule_bulk
+ *        call per distinct context. Tasks keep their order within a context.
+ *        Tasks without a context run right away on the calling thread.
+ *
+ * For sources that complete many tasks at once (timers, I/O readiness), so
+ * that each task list is woken once per batch instead of once per task.
+ */
+void schedule_grouped(std::vector<ContextTask> tasks);
+
 }  // namespace igasync
 
 #endif
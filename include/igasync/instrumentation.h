@@ -0,0 +1,101 @@
+#ifndef IGASYNC_INSTRUMENTATION_H
+#define IGASYNC_INSTRUMENTATION_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Hooks are only emitted if the library (and everything including its
+ * headers) is built with IGASYNC_ENABLE_INSTRUMENTATION=1 - set by the CMake
+ * option of the same name. Otherwise every emit point compiles to nothing.
+ */
+#ifndef IGASYNC_ENABLE_INSTRUMENTATION
+#define IGASYNC_ENABLE_INSTRUMENTATION 0
+#endif
+
+#if IGASYNC_ENABLE_INSTRUMENTATION
+#define IGASYNC_INSTRUMENT(event, ...) \
+  ::igasync::Instrumentation::event(__VA_ARGS__)
+#else
+#define IGASYNC_INSTRUMENT(event, ...) ((void)0)
+#endif
+
+namespace igasync {
+
+class ExecutionContext;
+class Task;
+
+/**
+ * @brief Subscriber type for low-level scheduler events, used to attach an
+ *        external profiler or sampling system.
+ *
+ * Callbacks run synchronously on the thread that caused the event, often on
+ * hot paths and sometimes while library locks are held - they must be quick,
+ * and must not schedule tasks or resolve promises themselves.
+ */
+class IInstrumentationObserver {
+ public:
+  virtual ~IInstrumentationObserver() = default;
+
+  virtual void on_task_scheduled(
+      const Task& /* task */,
+      const ExecutionContext& /* execution_context */) {}
+  virtual void on_task_started(const Task& /* task */) {}
+  virtual void on_task_finished(const Task& /* task */) {}
+
+  /** Promises are identified by address, which is reused once destroyed */
+  virtual void on_promise_created(const void* /* promise */) {}
+  virtual void on_promise_resolved(const void* /* promise */) {}
+
+  /** Worker index is the thread's position in ThreadPool::thread_ids() */
+  virtual void on_worker_parked(size_t /* worker_idx */) {}
+  virtual void on_worker_unparked(size_t /* worker_idx */) {}
+};
+
+/**
+ * @brief Global registry of instrumentation observers.
+ *
+ * Registration and emission are both lock-free: observers live in a small
+ * fixed array of atomic slots. Removing an observer does not wait for
+ * callbacks already in flight on other threads, so observers should outlive
+ * any work running in the process (e.g. be static).
+ */
+class Instrumentation {
+ public:
+  static constexpr size_t kMaxObservers = 8;
+
+  /**
+   * @return False if every observer slot is taken
+   */
+  static bool add_observer(IInstrumentationObserver* observer);
+  static void remove_observer(IInstrumentationObserver* observer);
+
+  /**
+   * @return True if hooks are compiled in
+   */
+  static constexpr bool is_compiled_in() {
+    return IGASYNC_ENABLE_INSTRUMENTATION != 0;
+  }
+
+  static void task_scheduled(const Task& task,
+                             const ExecutionContext& execution_context);
+  static void task_started(const Task& task);
+  static void task_finished(const Task& task);
+  static void promise_created(const void* promise);
+  static void promise_resolved(const void* promise);
+  static void worker_parked(size_t worker_idx);
+  static void worker_unparked(size_t worker_idx);
+
+ private:
+  template <typename F>
+  static void for_each_observer(F&& f);
+
+  static std::atomic_size_t observer_count_;
+  static std::array<std::atomic<IInstrumentationObserver*>, kMaxObservers>
+      observers_;
+};
+
+}  // namespace igasync
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef IGASYNC_JOB_SCHEDULER_H
+#define IGASYNC_JOB_SCHEDULER_H
+
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+#include <igasync/task_graph.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Schedules jobs that declare which named resources they read and
+ *        write, running everything that doesn't conflict in parallel.
+ *
+ * Jobs are ordered by submission only where their resource access conflicts:
+ * a job that reads a resource waits for the last job that wrote it, and a job
+ * that writes a resource waits for the last writer and every reader since.
+ * Readers of the same resource run concurrently. The resulting dependencies
+ * are compiled into a TaskGraph, so the schedule is built once and can be
+ * executed every simulation step.
+ *
+ * @code{.cc}
+ * auto sim = JobScheduler::Create();
+ * auto transforms = sim->resource("transforms");
+ * auto velocities = sim->resource("velocities");
+ * auto bounds = sim->resource("bounds");
+ *
+ * sim->add_job(integrate, {velocities}, {transforms});
+ * sim->add_job(apply_drag, {}, {velocities});      // waits for integrate
+ * sim->add_job(update_bounds, {transforms}, {bounds});  // waits for integrate
+ * sim->add_job(audio_listener, {transforms}, {});  // runs with update_bounds
+ *
+ * // Every step:
+ * sim->execute(async_tasks)->on_resolve(end_step, main_thread_tasks);
+ * @endcode
+ */
+class JobScheduler {
+ public:
+  using ResourceId = uint32_t;
+  using JobId = TaskGraph::NodeId;
+
+ public:
+  static std::shared_ptr<JobScheduler> Create();
+
+  JobScheduler(const JobScheduler&) = delete;
+  JobScheduler(JobScheduler&&) = delete;
+  JobScheduler& operator=(const JobScheduler&) = delete;
+  JobScheduler& operator=(JobScheduler&&) = delete;
+
+  /**
+   * @brief Get the identifier for a named resource, registering it if this is
+   *        the first time the name is seen
+   */
+  ResourceId resource(const std::string& name);
+
+  /**
+   * @brief Add a job that runs once per execution
+   * @param fn Job implementation
+   * @param reads Resources the job reads (shared with other readers)
+   * @param writes Resources the job writes (exclusive access)
+   * @return Identifier for the job
+   *
+   * Resource IDs not returned by resource() are ignored - the job is still
+   * added, but is not ordered against anything through them.
+   */
+  JobId add_job(std::function<void()> fn, std::vector<ResourceId> reads,
+                std::vector<ResourceId> writes);
+
+  /**
+   * @return The jobs that must finish before the given job may start, derived
+   *         from declared resource access
+   */
+  std::vector<JobId> dependencies_of(JobId job) const;
+
+  /**
+   * @brief Run every job once, as soon as the jobs it conflicts with finish
+   * @return Promise that resolves once every job has finished, or nullptr if
+   *         the previous execution is still running
+   */
+  std::shared_ptr<Promise<void>> execute(
+      std::shared_ptr<ExecutionContext> execution_context);
+
+ private:
+  JobScheduler();
+
+  struct ResourceState {
+    JobId LastWriter;
+    bool HasWriter;
+    std::vector<JobId> ReadersSinceWrite;
+  };
+
+ private:
+  mutable std::mutex m_jobs_;
+  std::unordered_map<std::string, ResourceId> resource_ids_;
+  std::vector<ResourceState> resources_;
+  std::vector<std::vector<JobId>> dependencies_;
+  std::shared_ptr<TaskGraph> graph_;
+};
+
+}  // namespace igasync
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef IGASYNC_METRICS_H
+#define IGASYNC_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Lock-free latency histogram with logarithmic buckets, in the style of
+ *        HdrHistogram.
+ *
+ * Every power of two is split into 8 linear sub-buckets, so any recorded value
+ * is reported to within 12.5% of its true value, from nanoseconds up to
+ * centuries. Recording is a handful of relaxed atomic adds and never blocks.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t kSubBucketBits = 3;
+  static constexpr size_t kSubBucketCount = 1ull << kSubBucketBits;
+  static constexpr size_t kBucketCount =
+      (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+  /**
+   * @brief Point-in-time copy of a histogram's contents
+   */
+  struct Snapshot {
+    std::array<uint64_t, kBucketCount> Buckets{};
+    uint64_t Count{0};
+    uint64_t TotalNs{0};
+    uint64_t MaxNs{0};
+
+    /**
+     * @brief Approximate value below which the given fraction of samples fall
+     * @param quantile Fraction in [0, 1], e.g. 0.99 for p99
+     */
+    std::chrono::nanoseconds percentile(double quantile) const;
+
+    std::chrono::nanoseconds mean() const;
+    std::chrono::nanoseconds max() const;
+  };
+
+ public:
+  LatencyHistogram() = default;
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void record(std::chrono::nanoseconds latency);
+  Snapshot snapshot() const;
+  void reset();
+
+  static size_t bucket_index(uint64_t ns);
+  static uint64_t bucket_lower_bound(size_t idx);
+
+ private:
+  std::array<std::atomic_uint64_t, kBucketCount> buckets_{};
+  std::atomic_uint64_t total_ns_{0};
+  std::atomic_uint64_t max_ns_{0};
+};
+
+/**
+ * @brief Snapshot of TaskList activity, returned by TaskList::metrics()
+ */
+struct TaskListMetrics {
+  /** Approximate number of tasks waiting to run */
+  size_t QueueDepth{0};
+
+  /** Tasks scheduled since creation (0 unless metrics are enabled) */
+  uint64_t Enqueued{0};
+
+  /** Tasks pulled off the list to run (0 unless metrics are enabled) */
+  uint64_t Dequeued{0};
+
+  /** Time between a task being scheduled and starting to run */
+  LatencyHistogram::Snapshot ScheduleToStart{};
+
+  /** Time spent running each task */
+  LatencyHistogram::Snapshot RunTime{};
+};
+
+/**
+ * @brief Snapshot of a single ThreadPool worker thread
+ */
+struct WorkerMetrics {
+  std::thread::id ThreadId{};
+  uint64_t TasksExecuted{0};
+
+  /** Number of times the worker went to sleep waiting for tasks */
+  uint64_t Parks{0};
+
+  /** Approximate time spent looking for and running tasks */
+  std::chrono::nanoseconds BusyTime{0};
+
+  /** Approximate time spent asleep waiting for tasks */
+  std::chrono::nanoseconds IdleTime{0};
+};
+
+/**
+ * @brief Snapshot of ThreadPool activity, returned by ThreadPool::metrics()
+ */
+struct ThreadPoolMetrics {
+  std::vector<WorkerMetrics> Workers;
+
+  uint64_t total_tasks_executed() const;
+
+  /** Fraction of worker time spent busy, in [0, 1] */
+  double utilization() const;
+};
+
+}  // namespace igasync
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef IGASYNC_PARALLEL_H
+#define IGASYNC_PARALLEL_H
+
+#include <igasync/concepts.h>
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <atomic>
+#include <concepts>
+#include <iterator>
+#include <memory>
+
+namespace igasync {
+
+/**
+ * @brief Describes how a data-parallel loop should be split up, with
+ *        reasonable defaults.
+ */
+struct ParallelDesc {
+  ParallelDesc() noexcept {}
+
+  /**
+   * @brief Smallest number of indices handed out at once (0 picks a grain
+   *        size from the range size and worker count)
+   */
+  size_t GrainSize{0};
+
+  /**
+   * @brief Number of threads expected to share the work, including the
+   *        calling thread (0 uses hardware concurrency)
+   */
+  size_t Concurrency{0};
+
+  /**
+   * @brief If set, the calling thread works through chunks of the range
+   *        before returning, instead of only scheduling helper tasks
+   */
+  bool CallerParticipates{true};
+
+  /**
+   * @brief If set, the range is split into fixed chunks whose boundaries
+   *        depend only on the range size and GrainSize (not the thread count),
+   *        and reductions combine partial results in chunk order. Use for
+   *        reproducible floating point reductions.
+   */
+  bool Deterministic{false};
+};
+
+/**
+ * @brief Value padded out to its own cache line, so that per-worker partial
+ *        results stored next to each other don't falsely share a line.
+ */
+template <typename T>
+struct alignas(64) CacheAligned {
+  T Value;
+};
+
+/**
+ * @brief Lock-free splitter that hands out chunks of an index range [0, size)
+ *        to whichever thread asks next, and counts down completed indices.
+ *
+ * Chunks are sized with guided self-scheduling: large while most of the range
+ * is unclaimed, shrinking to the grain size towards the end so that workers
+ * finish at roughly the same time.
+ */
+class RangePartitioner {
+ public:
+  RangePartitioner(size_t size, const ParallelDesc& desc);
+
+  /**
+   * @brief Claim the next chunk of the range
+   * @return False if the whole range is already claimed
+   */
+  bool claim(size_t& chunk_begin, size_t& chunk_end);
+
+  /**
+   * @brief Mark count indices as finished
+   * @return True for exactly one caller - the one that finished the range
+   */
+  bool complete(size_t count);
+
+  size_t size() const { return size_; }
+  size_t concurrency() const { return concurrency_; }
+  size_t grain_size() const { return grain_size_; }
+
+  /**
+   * @brief Number of chunks the range splits into in deterministic mode, where
+   *        chunk N covers [N * grain_size, (N + 1) * grain_size)
+   */
+  size_t chunk_count() const { return (size_ + grain_size_ - 1) / grain_size_; }
+
+  /**
+   * @brief Number of helper tasks worth scheduling to share this range
+   */
+  size_t helper_count(bool caller_participates) const;
+
+ private:
+  size_t size_;
+  size_t concurrency_;
+  size_t grain_size_;
+  bool is_deterministic_;
+
+  alignas(64) std::atomic_size_t next_;
+  alignas(64) std::atomic_size_t remaining_;
+};
+
+/**
+ * @brief Invoke body(i) for every i in [begin, end), spread across the threads
+ *        servicing execution_context.
+ *
+ * Instead of one task and promise per index, a handful of helper tasks are
+ * scheduled and pull adaptively sized chunks of the range from a shared
+ * partitioner, so per-index overhead is a function call. By default the
+ * calling thread also works through chunks before returning - set
+ * desc.CallerParticipates to false on a thread that must not block (e.g. the
+ * browser main thread).
+ *
+ * body may be invoked concurrently from several threads.
+ *
+ * @code{.cc}
+ * parallel_for(size_t{0}, entities.size(),
+ *              [&entities](size_t i) { entities[i].update_animation(); },
+ *              frame_async_tasks)
+ *     ->on_resolve([]() { render_frame(); }, main_thread_tasks);
+ * @endcode
+ *
+ * @return A promise that resolves once body has returned for every index
+ */
+template <std::integral IndexT, typename F>
+  requires(CanApplyFunctor<F, IndexT>)
+std::shared_ptr<Promise<void>> parallel_for(
+    IndexT begin, IndexT end, F&& body,
+    std::shared_ptr<ExecutionContext> execution_context,
+    ParallelDesc desc = ParallelDesc());
+
+/**
+ * @brief Reduce the index range [begin, end) to a single value, spread across
+ *        the threads servicing execution_context.
+ *
+ * Every participating thread folds the indices it claims into its own
+ * cache-line aligned partial (a copy of identity) with body(partial, i), and
+ * the partials are merged with combine(result, partial) once the whole range
+ * is done. With desc.Deterministic set there is one partial per fixed chunk
+ * instead, merged in chunk order, so the result doesn't depend on scheduling.
+ *
+ * @code{.cc}
+ * auto bounds = parallel_reduce(
+ *     size_t{0}, meshes.size(), AABB::Empty(),
+ *     [&meshes](AABB& box, size_t i) { box.merge(meshes[i].bounds()); },
+ *     [](AABB& box, AABB partial) { box.merge(partial); }, async_tasks);
+ * @endcode
+ *
+ * @param identity Identity value for combine, used to seed every partial
+ * @param body Callable as body(ValT&, IndexT), folds one index into a partial
+ * @param combine Callable as combine(ValT&, ValT), merges a partial
+ * @return A promise that resolves with the reduced value
+ */
+template <std::integral IndexT, typename ValT, typename F, typename CombineF>
+  requires(CanApplyFunctor<F, ValT&, IndexT> &&
+           CanApplyFunctor<CombineF, ValT&, ValT> &&
+           std::is_copy_constructible_v<ValT>)
+std::shared_ptr<Promise<ValT>> parallel_reduce(
+    IndexT begin, IndexT end, ValT identity, F&& body, CombineF&& combine,
+    std::shared_ptr<ExecutionContext> execution_context,
+    ParallelDesc desc = ParallelDesc());
+
+/**
+ * @brief Write the inclusive prefix "sum" of [first, last) under op to the
+ *        range starting at d_first, spread across the threads servicing
+ *        execution_context.
+ *
+ * Runs in two parallel passes over fixed chunks: the first reduces each chunk
+ * into a cache-line aligned partial, then the chunk offsets are prefixed
+ * serially, and the second pass scans each chunk starting from its offset. op
+ * must be associative. Chunking is always deterministic for scans, so the
+ * output does not depend on scheduling.
+ *
+ * The input and output ranges must stay alive until the returned promise
+ * resolves. d_first may equal first for an in-place scan.
+ *
+ * @param identity Identity value for op
+ * @param op Callable as op(const T&, const T&) -> T
+ * @return A promise that resolves once every output element is written
+ */
+template <std::random_access_iterator InIt, std::random_access_iterator OutIt,
+          typename T, typename Op>
+  requires(HasAppropriateFunctor<T, Op, const T&, const T&>)
+std::shared_ptr<Promise<void>> parallel_inclusive_scan(
+    InIt first, InIt last, OutIt d_first, T identity, Op&& op,
+    std::shared_ptr<ExecutionContext> execution_context,
+    ParallelDesc desc = ParallelDesc());
+
+}  // namespace igasync
+
+#include <igasync/parallel.inl>
+
+#endif
@@ -0,0 +1,264 @@
+#include <igasync/parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace igasync {
+
+template <std::integral IndexT, typename F>
+  requires(CanApplyFunctor<F, IndexT>)
+std::shared_ptr<Promise<void>> parallel_for(
+    IndexT begin, IndexT end, F&& body,
+    std::shared_ptr<ExecutionContext> execution_context, ParallelDesc desc) {
+  if (end <= begin) {
+    return Promise<void>::Immediate();
+  }
+
+  struct State {
+    State(IndexT begin, size_t size, std::decay_t<F> body,
+          const ParallelDesc& desc)
+        : Begin(begin),
+          Partitioner(size, desc),
+          Body(std::move(body)),
+          Done(Promise<void>::Create()) {}
+
+    IndexT Begin;
+    RangePartitioner Partitioner;
+    std::decay_t<F> Body;
+    std::shared_ptr<Promise<void>> Done;
+
+    void work() {
+      size_t chunk_begin = 0, chunk_end = 0;
+      while (Partitioner.claim(chunk_begin, chunk_end)) {
+        for (size_t i = chunk_begin; i < chunk_end; i++) {
+          Body(static_cast<IndexT>(Begin + i));
+        }
+        if (Partitioner.complete(chunk_end - chunk_begin)) {
+          Done->resolve();
+        }
+      }
+    }
+  };
+
+  auto state = std::make_shared<State>(
+      begin, static_cast<size_t>(end - begin), std::forward<F>(body), desc);
+  auto done = state->Done;
+
+  size_t helper_count =
+      state->Partitioner.helper_count(desc.CallerParticipates);
+  for (size_t i = 0; i < helper_count; i++) {
+    execution_context->schedule(Task::Of([state]() { state->work(); }));
+  }
+
+  if (desc.CallerParticipates) {
+    state->work();
+  }
+
+  return done;
+}
+
+template <std::integral IndexT, typename ValT, typename F, typename CombineF>
+  requires(CanApplyFunctor<F, ValT&, IndexT> &&
+           CanApplyFunctor<CombineF, ValT&, ValT> &&
+           std::is_copy_constructible_v<ValT>)
+std::shared_ptr<Promise<ValT>> parallel_reduce(
+    IndexT begin, IndexT end, ValT identity, F&& body, CombineF&& combine,
+    std::shared_ptr<ExecutionContext> execution_context, ParallelDesc desc) {
+  if (end <= begin) {
+    return Promise<ValT>::Immediate(std::move(identity));
+  }
+
+  struct State {
+    State(IndexT begin, size_t size, ValT identity, std::decay_t<F> body,
+          std::decay_t<CombineF> combine, const ParallelDesc& desc)
+        : Begin(begin),
+          Partitioner(size, desc),
+          IsDeterministic(desc.Deterministic),
+          Identity(std::move(identity)),
+          Body(std::move(body)),
+          Combine(std::move(combine)),
+          Done(Promise<ValT>::Create()) {}
+
+    IndexT Begin;
+    RangePartitioner Partitioner;
+    bool IsDeterministic;
+    ValT Identity;
+    std::decay_t<F> Body;
+    std::decay_t<CombineF> Combine;
+    std::vector<CacheAligned<ValT>> Partials;
+    std::shared_ptr<Promise<ValT>> Done;
+
+    void work(size_t slot) {
+      size_t chunk_begin = 0, chunk_end = 0;
+      while (Partitioner.claim(chunk_begin, chunk_end)) {
+        size_t partial_idx =
+            IsDeterministic ? chunk_begin / Partitioner.grain_size() : slot;
+        ValT& partial = Partials[partial_idx].Value;
+        for (size_t i = chunk_begin; i < chunk_end; i++) {
+          Body(partial, static_cast<IndexT>(Begin + i));
+        }
+        if (Partitioner.complete(chunk_end - chunk_begin)) {
+          finish();
+        }
+      }
+    }
+
+    void finish() {
+      ValT rsl = std::move(Identity);
+      for (auto& partial : Partials) {
+        Combine(rsl, std::move(partial.Value));
+      }
+      Done->resolve(std::move(rsl));
+    }
+  };
+
+  auto state = std::make_shared<State>(
+      begin, static_cast<size_t>(end - begin), std::move(identity),
+      std::forward<F>(body), std::forward<CombineF>(combine), desc);
+  auto done = state->Done;
+
+  size_t helper_count =
+      state->Partitioner.helper_count(desc.CallerParticipates);
+  size_t partial_count = desc.Deterministic
+                             ? state->Partitioner.chunk_count()
+                             : helper_count + 1;
+  state->Partials.reserve(partial_count);
+  for (size_t i = 0; i < partial_count; i++) {
+    state->Partials.push_back(CacheAligned<ValT>{state->Identity});
+  }
+
+  for (size_t i = 0; i < helper_count; i++) {
+    execution_context->schedule(Task::Of([state, i]() { state->work(i); }));
+  }
+
+  if (desc.CallerParticipates) {
+    state->work(helper_count);
+  }
+
+  return done;
+}
+
+template <std::random_access_iterator InIt, std::random_access_iterator OutIt,
+          typename T, typename Op>
+  requires(HasAppropriateFunctor<T, Op, const T&, const T&>)
+std::shared_ptr<Promise<void>> parallel_inclusive_scan(
+    InIt first, InIt last, OutIt d_first, T identity, Op&& op,
+    std::shared_ptr<ExecutionContext> execution_context, ParallelDesc desc) {
+  if (last <= first) {
+    return Promise<void>::Immediate();
+  }
+
+  desc.Deterministic = true;
+
+  ParallelDesc chunk_desc = desc;
+  chunk_desc.GrainSize = 1;
+
+  struct State {
+    State(InIt first, OutIt d_first, size_t size, T identity,
+          std::decay_t<Op> op, const ParallelDesc& desc,
+          const ParallelDesc& chunk_desc,
+          std::shared_ptr<ExecutionContext> execution_context)
+        : First(first),
+          DFirst(d_first),
+          Size(size),
+          Identity(std::move(identity)),
+          Fn(std::move(op)),
+          Elements(size, desc),
+          ReducePass(Elements.chunk_count(), chunk_desc),
+          ScanPass(Elements.chunk_count(), chunk_desc),
+          Scheduler(std::move(execution_context)),
+          Done(Promise<void>::Create()) {
+      ChunkOffsets.resize(Elements.chunk_count(),
+                          CacheAligned<T>{Identity});
+    }
+
+    InIt First;
+    OutIt DFirst;
+    size_t Size;
+    T Identity;
+    std::decay_t<Op> Fn;
+    RangePartitioner Elements;
+    RangePartitioner ReducePass;
+    RangePartitioner ScanPass;
+    std::vector<CacheAligned<T>> ChunkOffsets;
+    std::shared_ptr<ExecutionContext> Scheduler;
+    std::shared_ptr<Promise<void>> Done;
+
+    size_t chunk_begin(size_t chunk) const {
+      return chunk * Elements.grain_size();
+    }
+    size_t chunk_end(size_t chunk) const {
+      return std::min(Size, (chunk + 1) * Elements.grain_size());
+    }
+
+    void reduce_work(const std::shared_ptr<State>& self) {
+      size_t claim_begin = 0, claim_end = 0;
+      while (ReducePass.claim(claim_begin, claim_end)) {
+        for (size_t c = claim_begin; c < claim_end; c++) {
+          size_t end = chunk_end(c);
+          T sum = First[chunk_begin(c)];
+          for (size_t i = chunk_begin(c) + 1; i < end; i++) {
+            sum = Fn(sum, First[i]);
+          }
+          ChunkOffsets[c].Value = std::move(sum);
+        }
+        if (ReducePass.complete(claim_end - claim_begin)) {
+          start_scan_pass(self);
+        }
+      }
+    }
+
+    void start_scan_pass(const std::shared_ptr<State>& self) {
+      // Turn chunk sums into exclusive chunk offsets
+      T running = Identity;
+      for (auto& offset : ChunkOffsets) {
+        T sum = std::move(offset.Value);
+        offset.Value = running;
+        running = Fn(running, sum);
+      }
+
+      size_t helper_count = ScanPass.helper_count(true);
+      for (size_t i = 0; i < helper_count; i++) {
+        Scheduler->schedule(Task::Of([self]() { self->scan_work(); }));
+      }
+      scan_work();
+    }
+
+    void scan_work() {
+      size_t claim_begin = 0, claim_end = 0;
+      while (ScanPass.claim(claim_begin, claim_end)) {
+        for (size_t c = claim_begin; c < claim_end; c++) {
+          size_t end = chunk_end(c);
+          T running = ChunkOffsets[c].Value;
+          for (size_t i = chunk_begin(c); i < end; i++) {
+            running = Fn(running, First[i]);
+            DFirst[i] = running;
+          }
+        }
+        if (ScanPass.complete(claim_end - claim_begin)) {
+          Done->resolve();
+        }
+      }
+    }
+  };
+
+  auto state = std::make_shared<State>(
+      first, d_first, static_cast<size_t>(last - first), std::move(identity),
+      std::forward<Op>(op), desc, chunk_desc, execution_context);
+  auto done = state->Done;
+
+  size_t helper_count =
+      state->ReducePass.helper_count(desc.CallerParticipates);
+  for (size_t i = 0; i < helper_count; i++) {
+    execution_context->schedule(
+        Task::Of([state]() { state->reduce_work(state); }));
+  }
+
+  if (desc.CallerParticipates) {
+    state->reduce_work(state);
+  }
+
+  return done;
+}
+
+}  // namespace igasync
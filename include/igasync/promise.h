@@ -2,7 +2,12 @@
 #define IGASYNC_PROMISE_H
 
 #include <igasync/concepts.h>
+#include <igasync/dependency_recorder.h>
 #include <igasync/execution_context.h>
+#include <igasync/instrumentation.h>
+#include <igasync/promise_census.h>
+#include <igasync/task_label.h>
+#include <igasync/usdt.h>
 
 #include <functional>
 #include <memory>
@@ -45,11 +50,13 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
   struct ThenOp {
     std::function<void(const ValT&)> Fn;
     std::shared_ptr<ExecutionContext> Scheduler;
+    TaskLabel Label;
   };
 
   struct ConsumeOp {
     std::function<void(ValT&&)> Fn;
     std::shared_ptr<ExecutionContext> Scheduler;
+    TaskLabel Label;
   };
 
   Promise() : is_finished_(false), accept_thens_(true), remaining_thens_(0) {}
@@ -59,20 +66,25 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
   Promise(Promise<ValT>&&) = delete;
   Promise<ValT>& operator=(const Promise<ValT>&) = delete;
   Promise<ValT>& operator=(Promise<ValT>&&) = delete;
-  ~Promise<ValT>() = default;
+  ~Promise();
 
   /**
    * @brief Create a new, unresolved promise
+   * @param location Creation site, reported by the PromiseCensus
    * @return Non-null promise pointer
    */
-  static std::shared_ptr<Promise<ValT>> Create();
+  static std::shared_ptr<Promise<ValT>> Create(
+      std::source_location location = std::source_location::current());
 
   /**
    * @brief Create a new promise that's resolved with the provided value
    * @param val Value of the resolved promise
+   * @param location Creation site, reported by the PromiseCensus
    * @return Non-null promise pointer
    */
-  static std::shared_ptr<Promise<ValT>> Immediate(ValT val);
+  static std::shared_ptr<Promise<ValT>> Immediate(
+      ValT val,
+      std::source_location location = std::source_location::current());
 
   /**
    * @brief Finalize this promise with a successful result. This will
@@ -88,12 +100,15 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
    * @param f Callback implementation
    * @param execution_context Scheduler for callback - defaults to an
    *                          InlineExecutionContext implementation
+   * @param label Call site (and optional name) the callback is attributed to
+   *              when profiling
    * @return Shared pointer reference to this promise (for chaining)
    */
   template <typename F>
     requires(NonVoidPromiseThenCb<ValT, F>)
   std::shared_ptr<Promise<ValT>> on_resolve(
-      F&& f, std::shared_ptr<ExecutionContext> execution_context);
+      F&& f, std::shared_ptr<ExecutionContext> execution_context,
+      TaskLabel label = {});
 
   /**
    * @brief Schedule a callback to consume the final value when this promise
@@ -103,12 +118,15 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
    * @param f Callback implementation
    * @param execution_context Scheduler for callback - defaults to an
    *                          InlineExecutionContext implementation
+   * @param label Call site (and optional name) the callback is attributed to
+   *              when profiling
    * @return Shared pointer reference to this promise (for chaining)
    */
   template <typename F>
     requires(NonVoidPromiseConsumeCb<ValT, F>)
   std::shared_ptr<Promise<ValT>> consume(
-      F&& f, std::shared_ptr<ExecutionContext> execution_context);
+      F&& f, std::shared_ptr<ExecutionContext> execution_context,
+      TaskLabel label = {});
 
   /**
    * @return True if this promise is finished, false otherwise
@@ -141,13 +159,15 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
    * @param f
    * @param execution_context Scheduling mechanism to invoke the functor
    *                          against.
+   * @param label Call site (and optional name) f is attributed to when
+   *              profiling
    * @return A new promise
    */
   template <typename F,
             typename RslT = typename std::invoke_result_t<F, const ValT&>>
     requires(CanApplyFunctor<F, const ValT&>)
-  auto then(F&& f, std::shared_ptr<ExecutionContext> execution_context)
-      -> std::shared_ptr<Promise<RslT>>;
+  auto then(F&& f, std::shared_ptr<ExecutionContext> execution_context,
+            TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
 
   /**
    * @brief Create a new promise containing the result of a function invoked
@@ -156,13 +176,14 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
    * @tparam RslT
    * @param f
    * @param execution_context
+   * @param label
    * @return A new promise
    */
   template <typename F, typename RslT = typename std::invoke_result_t<F, ValT>>
     requires(CanApplyFunctor<F, ValT>)
   auto then_consuming(F&& f,
-                      std::shared_ptr<ExecutionContext> execution_context)
-      -> std::shared_ptr<Promise<RslT>>;
+                      std::shared_ptr<ExecutionContext> execution_context,
+                      TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
 
   /**
    * @brief Create a new promise containing the result of a promise returned
@@ -175,6 +196,8 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
    *        promise before passing to the callback function
    * @param inner_execution_context_override Scheduling mechanism for
    *        resolving the promise returned by f
+   * @param label Call site (and optional name) f is attributed to when
+   *              profiling
    * @return
    */
   template <typename F, typename RslT = typename std::invoke_result_t<
@@ -184,8 +207,8 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
   auto then_chain(F&& f,
                   std::shared_ptr<ExecutionContext> outer_execution_context,
                   std::shared_ptr<ExecutionContext>
-                      inner_execution_context_override = nullptr)
-      -> std::shared_ptr<Promise<RslT>>;
+                      inner_execution_context_override = nullptr,
+                  TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
 
   /**
    * @brief Chain a promise-producing method with this promise, consuming the
@@ -195,6 +218,7 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
    * @param f
    * @param outer_execution_context
    * @param inner_execution_context_override
+   * @param label
    * @return
    */
   template <typename F, typename RslT = typename std::invoke_result_t<
@@ -203,7 +227,8 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
   auto then_chain_consuming(
       F&& f, std::shared_ptr<ExecutionContext> outer_execution_context,
       std::shared_ptr<ExecutionContext> inner_execution_context_override =
-          nullptr) -> std::shared_ptr<Promise<RslT>>;
+          nullptr,
+      TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
 
  private:
   void maybe_consume();
@@ -218,6 +243,9 @@ class Promise : public std::enable_shared_from_this<Promise<ValT>> {
   std::atomic_bool accept_thens_;
 
   std::atomic_int remaining_thens_;
+
+  // Only set if the PromiseCensus was enabled when this promise was created
+  PromiseCensus::Entry* census_entry_{nullptr};
 };
 
 /**
@@ -237,6 +265,7 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
   struct ThenOp {
     std::function<void()> Fn;
     std::shared_ptr<ExecutionContext> Scheduler;
+    TaskLabel Label;
   };
 
   Promise() : is_finished_(false) {}
@@ -246,20 +275,24 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
   Promise(Promise<void>&&) = delete;
   Promise<void>& operator=(const Promise<void>&) = delete;
   Promise<void>& operator=(Promise<void>&&) = delete;
-  ~Promise<void>() = default;
+  ~Promise();
 
  public:
   /**
    * @brief Create a new, unresolved void promise
+   * @param location Creation site, reported by the PromiseCensus
    * @return Non-null promise pointer
    */
-  static std::shared_ptr<Promise<void>> Create();
+  static std::shared_ptr<Promise<void>> Create(
+      std::source_location location = std::source_location::current());
 
   /**
    * @brief Create a new, already resolved void promise
+   * @param location Creation site, reported by the PromiseCensus
    * @return Non-null promise pointer
    */
-  static std::shared_ptr<Promise<void>> Immediate();
+  static std::shared_ptr<Promise<void>> Immediate(
+      std::source_location location = std::source_location::current());
 
   /**
    * @brief Resolve this void promise, marking it as finished
@@ -273,12 +306,15 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
    * @param f Callback implementation
    * @param execution_context Scheduler for callback - defaults to an
    *                          InlineExecutionContext implementation
+   * @param label Call site (and optional name) the callback is attributed to
+   *              when profiling
    * @return Shared pointer reference to this promise (for chaining)
    */
   template <typename F>
     requires(VoidPromiseThenCb<F>)
   std::shared_ptr<Promise<void>> on_resolve(
-      F&& f, std::shared_ptr<ExecutionContext> execution_context);
+      F&& f, std::shared_ptr<ExecutionContext> execution_context,
+      TaskLabel label = {});
 
   /**
    * @brief Schedule a callback to be invoked when this promise resolves, and
@@ -287,12 +323,13 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
    * @tparam RslT
    * @param f
    * @param execution_context
+   * @param label
    * @return
    */
   template <typename F, typename RslT = typename std::invoke_result_t<F>>
     requires(CanApplyFunctor<F>)
-  auto then(F&& f, std::shared_ptr<ExecutionContext> execution_context)
-      -> std::shared_ptr<Promise<RslT>>;
+  auto then(F&& f, std::shared_ptr<ExecutionContext> execution_context,
+            TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
 
   /**
    * @brief Create a new promise containing the result of a promise returned
@@ -304,6 +341,8 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
    *        promise before passing to the callback function
    * @param inner_execution_context_override Scheduling mechanism for
    *        resolving the promise returned by f
+   * @param label Call site (and optional name) f is attributed to when
+   *              profiling
    * @return
    */
   template <typename F, typename RslT = typename std::invoke_result_t<
@@ -312,8 +351,8 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
   auto then_chain(F&& f,
                   std::shared_ptr<ExecutionContext> outer_execution_context,
                   std::shared_ptr<ExecutionContext>
-                      inner_execution_context_override = nullptr)
-      -> std::shared_ptr<Promise<RslT>>;
+                      inner_execution_context_override = nullptr,
+                  TaskLabel label = {}) -> std::shared_ptr<Promise<RslT>>;
 
   /**
    * @return True if this promise is finished, false otherwise
@@ -325,6 +364,9 @@ class Promise<void> : public std::enable_shared_from_this<Promise<void>> {
   std::queue<ThenOp> then_queue_;
 
   std::atomic_bool is_finished_;
+
+  // Only set if the PromiseCensus was enabled when this promise was created
+  PromiseCensus::Entry* census_entry_{nullptr};
 };
 
 }  // namespace igasync
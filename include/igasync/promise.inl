@@ -5,35 +5,68 @@
 namespace igasync {
 
 template <class ValT>
-std::shared_ptr<Promise<ValT>> Promise<ValT>::Create() {
-  return std::shared_ptr<Promise<ValT>>(new Promise<ValT>());
+std::shared_ptr<Promise<ValT>> Promise<ValT>::Create(
+    std::source_location location) {
+  auto p = std::shared_ptr<Promise<ValT>>(new Promise<ValT>());
+  IGASYNC_INSTRUMENT(promise_created, p.get());
+  if (PromiseCensus::is_enabled()) {
+    p->census_entry_ = PromiseCensus::Get().add(p.get(), location);
+  }
+  return p;
 }
 
 template <class ValT>
-std::shared_ptr<Promise<ValT>> Promise<ValT>::Immediate(ValT val) {
-  auto p = Create();
+std::shared_ptr<Promise<ValT>> Promise<ValT>::Immediate(
+    ValT val, std::source_location location) {
+  auto p = Create(location);
   p->resolve(std::move(val));
   return p;
 }
 
 template <class ValT>
-std::shared_ptr<Promise<ValT>> Promise<ValT>::resolve(ValT val) {
-  std::scoped_lock l(m_result_);
-  if (result_.has_value()) {
-    // TODO (sessamekesh): Handle this error case (global callback on
-    // double-resolve registered against igasync singleton?)
-    return nullptr;
+Promise<ValT>::~Promise() {
+  if (census_entry_ != nullptr) {
+    PromiseCensus::Get().remove(census_entry_);
   }
+}
+
+template <class ValT>
+std::shared_ptr<Promise<ValT>> Promise<ValT>::resolve(ValT val) {
+  std::queue<ThenOp> pending_thens;
+  {
+    std::scoped_lock l(m_result_);
+    if (result_.has_value()) {
+      // TODO (sessamekesh): Handle this error case (global callback on
+      // double-resolve registered against igasync singleton?)
+      return nullptr;
+    }
 
-  result_ = std::move(val);
-  is_finished_ = true;
+    result_ = std::move(val);
+    is_finished_ = true;
+    std::swap(pending_thens, then_queue_);
 
-  // Flush queue of pending operations
-  while (!then_queue_.empty()) {
-    ThenOp v = std::move(then_queue_.front());
-    then_queue_.pop();
+    if (census_entry_ != nullptr) {
+      census_entry_->IsResolved = true;
+      census_entry_->PendingContinuations = 0;
+      census_entry_->CapturedBytes = 0;
+    }
+  }
+  IGASYNC_INSTRUMENT(promise_resolved, this);
+  IGASYNC_PROBE1(promise__resolve, this);
+  if (DependencyRecorder::is_recording()) {
+    DependencyRecorder::Get().on_promise_resolved(this);
+  }
 
-    v.Scheduler->schedule(Task::Of(
+  // Flush queue of pending operations outside of the lock - execution contexts
+  // are free to run the task inline (see RaceExecutionContext), and the task
+  // itself takes the lock to update bookkeeping. Pending thens are still
+  // counted in remaining_thens_, so a consumer cannot sneak in early.
+  while (!pending_thens.empty()) {
+    ThenOp v = std::move(pending_thens.front());
+    pending_thens.pop();
+
+    v.Scheduler->schedule(Task::Continuation(
+        this, v.Label,
         [fn = std::move(v.Fn), this, lifetime = this->shared_from_this()]() {
           fn(*result_);
           std::scoped_lock l(this->m_result_);
@@ -42,7 +75,10 @@ std::shared_ptr<Promise<ValT>> Promise<ValT>::resolve(ValT val) {
         }));
   }
 
-  maybe_consume();
+  {
+    std::scoped_lock l(m_result_);
+    maybe_consume();
+  }
 
   return this->shared_from_this();
 }
@@ -51,7 +87,8 @@ template <class ValT>
 template <class F>
   requires(NonVoidPromiseThenCb<ValT, F>)
 std::shared_ptr<Promise<ValT>> Promise<ValT>::on_resolve(
-    F&& f, std::shared_ptr<ExecutionContext> execution_context) {
+    F&& f, std::shared_ptr<ExecutionContext> execution_context,
+    TaskLabel label) {
   std::scoped_lock l(m_result_);
   if (!accept_thens_) {
     // TODO (sessamekesh): Invoke a global callback here
@@ -59,15 +96,22 @@ std::shared_ptr<Promise<ValT>> Promise<ValT>::on_resolve(
   }
 
   if (result_.has_value()) {
-    execution_context->schedule(
-        Task::Of([fn = std::move(f), this,
-                  lifetime = this->shared_from_this()]() { fn(*result_); }));
+    execution_context->schedule(Task::Continuation(
+        this, label,
+        [fn = std::move(f), this, lifetime = this->shared_from_this()]() {
+          fn(*result_);
+        }));
     return this->shared_from_this();
   }
 
   // Promsie is still pending - add as a callback
   remaining_thens_++;
-  then_queue_.emplace(ThenOp{std::move(f), std::move(execution_context)});
+  if (census_entry_ != nullptr) {
+    census_entry_->PendingContinuations++;
+    census_entry_->CapturedBytes += sizeof(F);
+  }
+  then_queue_.emplace(
+      ThenOp{std::move(f), std::move(execution_context), label});
   return this->shared_from_this();
 }
 
@@ -81,7 +125,8 @@ template <class ValT>
 template <typename F>
   requires(NonVoidPromiseConsumeCb<ValT, F>)
 std::shared_ptr<Promise<ValT>> Promise<ValT>::consume(
-    F&& f, std::shared_ptr<ExecutionContext> execution_context) {
+    F&& f, std::shared_ptr<ExecutionContext> execution_context,
+    TaskLabel label) {
   std::scoped_lock l(m_result_);
   if (!accept_thens_) {
     // TODO (sessamekesh): Error handling here, this promise is already consume
@@ -91,7 +136,8 @@ std::shared_ptr<Promise<ValT>> Promise<ValT>::consume(
   accept_thens_ = false;
 
   if (remaining_thens_ == 0 && result_.has_value()) {
-    execution_context->schedule(Task::Of(
+    execution_context->schedule(Task::Continuation(
+        this, label,
         [f = std::move(f), this, lifetime = this->shared_from_this()]() {
           f(std::move(*result_));
         }));
@@ -99,7 +145,11 @@ std::shared_ptr<Promise<ValT>> Promise<ValT>::consume(
   }
 
   // Promise is still pending, add this as a callback
-  consume_ = ConsumeOp{std::move(f), std::move(execution_context)};
+  if (census_entry_ != nullptr && !result_.has_value()) {
+    census_entry_->PendingContinuations++;
+    census_entry_->CapturedBytes += sizeof(F);
+  }
+  consume_ = ConsumeOp{std::move(f), std::move(execution_context), label};
   return this->shared_from_this();
 }
 
@@ -117,9 +167,9 @@ template <class ValT>
 template <typename F, typename RslT>
   requires(CanApplyFunctor<F, const ValT&>)
 auto Promise<ValT>::then(F&& f,
-                         std::shared_ptr<ExecutionContext> execution_context)
-    -> std::shared_ptr<Promise<RslT>> {
-  auto tr = Promise<RslT>::Create();
+                         std::shared_ptr<ExecutionContext> execution_context,
+                         TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
+  auto tr = Promise<RslT>::Create(label.Location);
 
   on_resolve(
       [tr, f = std::move(f)](const ValT& v) {
@@ -130,7 +180,7 @@ auto Promise<ValT>::then(F&& f,
           tr->resolve(f(v));
         }
       },
-      execution_context);
+      execution_context, label);
   return tr;
 }
 
@@ -138,9 +188,9 @@ template <class ValT>
 template <typename F, typename RslT>
   requires(CanApplyFunctor<F, ValT>)
 auto Promise<ValT>::then_consuming(
-    F&& f, std::shared_ptr<ExecutionContext> execution_context)
-    -> std::shared_ptr<Promise<RslT>> {
-  auto tr = Promise<RslT>::Create();
+    F&& f, std::shared_ptr<ExecutionContext> execution_context,
+    TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
+  auto tr = Promise<RslT>::Create(label.Location);
 
   consume(
       [tr, f = std::move(f)](ValT v) {
@@ -151,7 +201,7 @@ auto Promise<ValT>::then_consuming(
           tr->resolve(f(std::move(v)));
         }
       },
-      execution_context);
+      execution_context, label);
   return tr;
 }
 
@@ -161,13 +211,13 @@ template <typename F, typename RslT>
       HasAppropriateFunctor<std::shared_ptr<Promise<RslT>>, F, const ValT&>)
 auto Promise<ValT>::then_chain(
     F&& f, std::shared_ptr<ExecutionContext> outer_execution_context,
-    std::shared_ptr<ExecutionContext> inner_execution_context_override)
-    -> std::shared_ptr<Promise<RslT>> {
+    std::shared_ptr<ExecutionContext> inner_execution_context_override,
+    TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
   if (inner_execution_context_override == nullptr) {
     inner_execution_context_override = outer_execution_context;
   }
 
-  auto tr = Promise<RslT>::Create();
+  auto tr = Promise<RslT>::Create(label.Location);
   on_resolve(
       [tr, f = std::move(f),
        inner_execution_context_override](const ValT& val) {
@@ -179,7 +229,7 @@ auto Promise<ValT>::then_chain(
                           inner_execution_context_override);
         }
       },
-      outer_execution_context);
+      outer_execution_context, label);
   return tr;
 }
 
@@ -188,13 +238,13 @@ template <typename F, typename RslT>
   requires(HasAppropriateFunctor<std::shared_ptr<Promise<RslT>>, F, ValT>)
 auto Promise<ValT>::then_chain_consuming(
     F&& f, std::shared_ptr<ExecutionContext> outer_execution_context,
-    std::shared_ptr<ExecutionContext> inner_execution_context_override)
-    -> std::shared_ptr<Promise<RslT>> {
+    std::shared_ptr<ExecutionContext> inner_execution_context_override,
+    TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
   if (inner_execution_context_override == nullptr) {
     inner_execution_context_override = outer_execution_context;
   }
 
-  auto tr = Promise<RslT>::Create();
+  auto tr = Promise<RslT>::Create(label.Location);
   consume(
       [tr, f = std::move(f), inner_execution_context_override](ValT val) {
         if constexpr (std::is_void_v<RslT>) {
@@ -207,15 +257,18 @@ auto Promise<ValT>::then_chain_consuming(
                         inner_execution_context_override);
         }
       },
-      outer_execution_context);
+      outer_execution_context, label);
   return tr;
 }
 
 template <class ValT>
 void Promise<ValT>::maybe_consume() {
-  if (remaining_thens_ == 0 && consume_.has_value()) {
-    consume_->Scheduler->schedule(Task::Of(
-        [fn = std::move(consume_->Fn), this,
+  if (remaining_thens_ == 0 && consume_.has_value() && result_.has_value()) {
+    ConsumeOp op = std::move(*consume_);
+    consume_.reset();
+    op.Scheduler->schedule(Task::Continuation(
+        this, op.Label,
+        [fn = std::move(op.Fn), this,
          lifetime = this->shared_from_this()]() { fn(std::move(*result_)); }));
   }
 }
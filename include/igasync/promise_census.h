@@ -0,0 +1,123 @@
+#ifndef IGASYNC_PROMISE_CENSUS_H
+#define IGASYNC_PROMISE_CENSUS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <unordered_set>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Point-in-time description of one live promise
+ */
+struct LivePromiseInfo {
+  const void* Promise{nullptr};
+
+  /** Call site that created the promise (may be empty) */
+  std::source_location Location{};
+
+  std::chrono::nanoseconds Age{0};
+  bool IsResolved{false};
+
+  /** Continuations queued on the promise, waiting for it to resolve */
+  size_t PendingContinuations{0};
+
+  /**
+   * @brief Approximate size of the callables held by pending continuations -
+   *        captured state that lives as long as the promise stays pending
+   */
+  size_t CapturedBytes{0};
+};
+
+/**
+ * @brief Opt-in registry of live promises, for finding promises that never
+ *        resolve (and everything their continuations keep alive).
+ *
+ * Only promises created while the census is enabled are tracked; they stay
+ * tracked until destroyed even if the census is disabled in the meantime.
+ *
+ * @code{.cc}
+ * PromiseCensus::Get().enable();
+ * run_for_a_while();
+ *
+ * // Anything pending for more than 30 seconds is suspicious
+ * PromiseCensus::Get().write_report(std::cerr, std::chrono::seconds(30));
+ * @endcode
+ */
+class PromiseCensus {
+ public:
+  /**
+   * @brief Bookkeeping for a tracked promise, updated by the promise itself
+   */
+  struct Entry {
+    const void* Promise;
+    std::source_location Location;
+    std::chrono::steady_clock::time_point CreatedAt;
+    std::atomic_bool IsResolved{false};
+    std::atomic_size_t PendingContinuations{0};
+    std::atomic_size_t CapturedBytes{0};
+  };
+
+ public:
+  static PromiseCensus& Get();
+
+  static bool is_enabled() {
+    return is_enabled_.load(std::memory_order_relaxed);
+  }
+
+  PromiseCensus(const PromiseCensus&) = delete;
+  PromiseCensus(PromiseCensus&&) = delete;
+  PromiseCensus& operator=(const PromiseCensus&) = delete;
+  PromiseCensus& operator=(PromiseCensus&&) = delete;
+
+  void enable();
+  void disable();
+
+  /**
+   * @brief Called by promises - start tracking a newly created promise
+   */
+  Entry* add(const void* promise, std::source_location location);
+
+  /**
+   * @brief Called by promises - stop tracking a destroyed promise
+   */
+  void remove(Entry* entry);
+
+  /**
+   * @return Every tracked promise, oldest first
+   * @param include_resolved Also report promises that have resolved but are
+   *                         still referenced
+   */
+  std::vector<LivePromiseInfo> snapshot(bool include_resolved = false) const;
+
+  /**
+   * @brief Write pending promises at least min_age old, grouped by creation
+   *        site with the largest groups first
+   */
+  void write_report(
+      std::ostream& out,
+      std::chrono::nanoseconds min_age = std::chrono::nanoseconds(0)) const;
+
+  /**
+   * @return Number of tracked promises (resolved or not)
+   */
+  size_t live_count() const;
+
+ private:
+  PromiseCensus() = default;
+
+ private:
+  static std::atomic_bool is_enabled_;
+
+  mutable std::mutex m_entries_;
+  std::unordered_set<Entry*> entries_;
+};
+
+}  // namespace igasync
+
+#endif
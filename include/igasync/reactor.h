@@ -0,0 +1,193 @@
+#ifndef IGASYNC_REACTOR_H
+#define IGASYNC_REACTOR_H
+
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Turns readiness of file descriptors (pipes, sockets, eventfds,
+ *        timerfds...) into resolved promises, using epoll.
+ *
+ * Waiting for a descriptor costs no thread: one epoll loop watches every
+ * descriptor, either on a dedicated reactor thread or pumped by calling
+ * poll() (e.g. from a recurring TaskList task). All promises completed by one
+ * poll wakeup are handed to their execution context with a single
+ * schedule_bulk call, so a burst of readiness wakes each thread pool once.
+ *
+ * Each descriptor may be waited on by several callers at once - waiters for
+ * the same direction (read or write) are served in the order they were added.
+ * read_some and write_some do at most one read or write call per wakeup, so
+ * they never block the reactor, even on a descriptor without O_NONBLOCK.
+ *
+ * Only available on Linux - Create() returns nullptr elsewhere.
+ *
+ * @code{.cc}
+ * auto reactor = Reactor::Create();
+ * reactor->read_some(socket_fd, buffer, async_tasks)
+ *     ->consume([&buffer](size_t size) { parse_message(buffer, size); },
+ *               async_tasks);
+ * @endcode
+ */
+class Reactor {
+ public:
+  /**
+   * @brief Describes all parameters used to construct a Reactor, with
+   *        reasonable defaults.
+   */
+  struct Desc {
+    Desc() noexcept {}
+
+    /**
+     * Run the epoll loop on a thread owned by the reactor. If false, nothing
+     * resolves until poll() is called.
+     */
+    bool UseDedicatedThread{true};
+
+    /** Most descriptor events handled per poll wakeup */
+    uint32_t MaxEventsPerPoll{64};
+
+    /** Name of the reactor thread reported to the TraceRecorder */
+    std::string Name{"igasync reactor"};
+  };
+
+ public:
+  /**
+   * @return New reactor, or nullptr if epoll is not available
+   */
+  static std::shared_ptr<Reactor> Create(Desc desc = Desc());
+
+  /**
+   * @brief Stops the reactor thread. Promises still waiting on a descriptor
+   *        are never resolved.
+   */
+  ~Reactor();
+
+  Reactor(const Reactor&) = delete;
+  Reactor(Reactor&&) = delete;
+  Reactor& operator=(const Reactor&) = delete;
+  Reactor& operator=(Reactor&&) = delete;
+
+  /**
+   * @brief Resolves once fd can be read from without blocking - including at
+   *        end of file, and after an error or hang-up
+   * @param completion_context Where the returned promise is resolved. If null,
+   *        it is resolved on whichever thread is polling the reactor.
+   */
+  std::shared_ptr<Promise<void>> when_readable(
+      int fd, std::shared_ptr<ExecutionContext> completion_context = nullptr);
+
+  /**
+   * @brief Resolves once fd can be written to without blocking, or after an
+   *        error or hang-up
+   */
+  std::shared_ptr<Promise<void>> when_writable(
+      int fd, std::shared_ptr<ExecutionContext> completion_context = nullptr);
+
+  /**
+   * @brief Once fd is readable, read up to buffer.size() bytes into buffer
+   * @return Promise with the number of bytes read - 0 at end of file, or if
+   *         the read failed. buffer must stay alive until it resolves.
+   */
+  std::shared_ptr<Promise<size_t>> read_some(
+      int fd, std::span<std::byte> buffer,
+      std::shared_ptr<ExecutionContext> completion_context = nullptr);
+
+  /**
+   * @brief Once fd is writable, write up to data.size() bytes from data.
+   *        Sockets are written with MSG_NOSIGNAL; writing to a pipe with no
+   *        reader raises SIGPIPE as usual.
+   * @return Promise with the number of bytes written - 0 if the write failed.
+   *         data must stay alive until it resolves.
+   */
+  std::shared_ptr<Promise<size_t>> write_some(
+      int fd, std::span<const std::byte> data,
+      std::shared_ptr<ExecutionContext> completion_context = nullptr);
+
+  /**
+   * @brief Stop watching fd, dropping its waiters without resolving them.
+   *        Call before closing a descriptor that still has waiters.
+   */
+  void remove(int fd);
+
+  /**
+   * @brief Wait up to timeout for descriptor events and complete the waiters
+   *        they satisfy. Called by the reactor thread if there is one - call
+   *        it from only one thread at a time otherwise.
+   * @param timeout Negative to wait until there is an event
+   * @return Number of waiters completed
+   */
+  size_t poll(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+  /**
+   * @return Number of descriptors with at least one waiter
+   */
+  size_t watched_fd_count() const;
+
+ private:
+  Reactor(Desc desc, int epoll_fd, int wake_fd);
+
+  struct Waiter {
+    enum class Op { Ready, Read, Write };
+
+    Op Kind{Op::Ready};
+    std::byte* Data{nullptr};
+    size_t Size{0};
+    std::shared_ptr<Promise<void>> ReadyResult;
+    std::shared_ptr<Promise<size_t>> SizeResult;
+    std::shared_ptr<ExecutionContext> CompletionContext;
+  };
+
+  struct FdState {
+    std::deque<Waiter> Readers;
+    std::deque<Waiter> Writers;
+
+    /** Set while fd is in the epoll interest list */
+    bool IsRegistered{false};
+  };
+
+  void add_waiter(int fd, bool is_write, Waiter waiter);
+
+  /**
+   * Requires m_fds_. Re-arms fd for the directions that have waiters, or
+   * serves them right away if epoll can not watch fd (e.g. a regular file).
+   */
+  void arm(int fd, FdState& state, std::vector<ContextTask>& completions);
+
+  /**
+   * Requires m_fds_. Serves waiters at the front of the queue, doing at most
+   * one read or write call. Returns false if no waiter was served.
+   */
+  static bool serve(int fd, std::deque<Waiter>& waiters,
+                    std::vector<ContextTask>& completions);
+
+  void run_thread();
+
+ private:
+  Desc desc_;
+  int epoll_fd_;
+  int wake_fd_;
+  std::atomic_bool is_stopping_;
+  std::thread reactor_thread_;
+
+  mutable std::mutex m_fds_;
+  std::unordered_map<int, FdState> fds_;
+};
+
+}  // namespace igasync
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef IGASYNC_REDUCE_AS_RESOLVED_H
+#define IGASYNC_REDUCE_AS_RESOLVED_H
+
+#include <igasync/concepts.h>
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace igasync {
+
+template <typename F, typename AccT, typename T>
+concept FoldsInto = std::is_invocable_v<F, AccT&, T>;
+
+/**
+ * @brief Fold the values of many promises into a single accumulator, as each
+ *        promise resolves.
+ *
+ * Unlike PromiseCombiner::combine, no input value is held until the end - each
+ * one is consumed from its promise, folded into the accumulator on the given
+ * execution context, and dropped. Peak memory is the accumulator plus whatever
+ * inputs are being folded at that moment.
+ *
+ * Folds are serialized against a single accumulator, so fold_fn never runs
+ * concurrently with itself. Input promises are consumed, and may not have any
+ * other consumers.
+ *
+ * @code{.cc}
+ * auto total_triangles = reduce_as_resolved(
+ *     chunk_promises, size_t{0},
+ *     [](size_t& acc, ChunkStats stats) { acc += stats.triangle_count; },
+ *     async_tasks);
+ * @endcode
+ *
+ * @param promises Promises whose values should be folded together
+ * @param init Initial accumulator value (final value if promises is empty)
+ * @param fold_fn Callable as fold_fn(AccT&, T), folds one value in
+ * @param execution_context Scheduler for fold callbacks
+ * @return A promise that resolves with the accumulator once every input has
+ *         been folded in
+ */
+template <typename T, typename AccT, typename FoldF>
+  requires(!IsVoid<T> && FoldsInto<FoldF, AccT, T>)
+std::shared_ptr<Promise<AccT>> reduce_as_resolved(
+    const std::vector<std::shared_ptr<Promise<T>>>& promises, AccT init,
+    FoldF&& fold_fn, std::shared_ptr<ExecutionContext> execution_context);
+
+/**
+ * @brief Sharded overload of reduce_as_resolved, for execution contexts that
+ *        are serviced by many threads at once.
+ *
+ * Each executing thread folds into one of several cache-line separated
+ * partial accumulators (each a copy of init), so folds on different workers
+ * don't contend for one lock. Partials are combined with merge_fn, in a fixed
+ * order, once the last input has been folded - init must therefore be an
+ * identity value for merge_fn.
+ *
+ * @param merge_fn Callable as merge_fn(AccT&, AccT), merges a partial into
+ *                 the final accumulator
+ */
+template <typename T, typename AccT, typename FoldF, typename MergeF>
+  requires(!IsVoid<T> && FoldsInto<FoldF, AccT, T> &&
+           FoldsInto<MergeF, AccT, AccT> && std::is_copy_constructible_v<AccT>)
+std::shared_ptr<Promise<AccT>> reduce_as_resolved(
+    const std::vector<std::shared_ptr<Promise<T>>>& promises, AccT init,
+    FoldF&& fold_fn, MergeF&& merge_fn,
+    std::shared_ptr<ExecutionContext> execution_context);
+
+}  // namespace igasync
+
+#include <igasync/reduce_as_resolved.inl>
+
+#endif
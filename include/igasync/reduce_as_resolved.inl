@@ -0,0 +1,130 @@
+#include <igasync/reduce_as_resolved.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace igasync {
+
+template <typename T, typename AccT, typename FoldF>
+  requires(!IsVoid<T> && FoldsInto<FoldF, AccT, T>)
+std::shared_ptr<Promise<AccT>> reduce_as_resolved(
+    const std::vector<std::shared_ptr<Promise<T>>>& promises, AccT init,
+    FoldF&& fold_fn, std::shared_ptr<ExecutionContext> execution_context) {
+  struct State {
+    State(AccT init, std::decay_t<FoldF> fold, size_t remaining)
+        : Accumulator(std::move(init)),
+          Fold(std::move(fold)),
+          Remaining(remaining) {}
+
+    std::mutex MAccumulator;
+    AccT Accumulator;
+    std::decay_t<FoldF> Fold;
+    std::atomic_size_t Remaining;
+  };
+
+  if (promises.empty()) {
+    return Promise<AccT>::Immediate(std::move(init));
+  }
+
+  auto rsl = Promise<AccT>::Create();
+  auto state = std::make_shared<State>(
+      std::move(init), std::forward<FoldF>(fold_fn), promises.size());
+
+  for (const auto& promise : promises) {
+    promise->consume(
+        [rsl, state](T val) {
+          {
+            std::lock_guard l(state->MAccumulator);
+            state->Fold(state->Accumulator, std::move(val));
+          }
+
+          if (state->Remaining.fetch_sub(1) == 1) {
+            rsl->resolve(std::move(state->Accumulator));
+          }
+        },
+        execution_context);
+  }
+
+  return rsl;
+}
+
+template <typename T, typename AccT, typename FoldF, typename MergeF>
+  requires(!IsVoid<T> && FoldsInto<FoldF, AccT, T> &&
+           FoldsInto<MergeF, AccT, AccT> && std::is_copy_constructible_v<AccT>)
+std::shared_ptr<Promise<AccT>> reduce_as_resolved(
+    const std::vector<std::shared_ptr<Promise<T>>>& promises, AccT init,
+    FoldF&& fold_fn, MergeF&& merge_fn,
+    std::shared_ptr<ExecutionContext> execution_context) {
+  struct alignas(64) Shard {
+    Shard(const AccT& init) : Partial(init) {}
+
+    std::mutex MPartial;
+    AccT Partial;
+  };
+
+  struct State {
+    State(AccT init, std::decay_t<FoldF> fold, std::decay_t<MergeF> merge,
+          size_t remaining, size_t num_shards)
+        : Init(std::move(init)),
+          Fold(std::move(fold)),
+          Merge(std::move(merge)),
+          Remaining(remaining) {
+      Shards.reserve(num_shards);
+      for (size_t i = 0; i < num_shards; i++) {
+        Shards.push_back(std::make_unique<Shard>(Init));
+      }
+    }
+
+    AccT Init;
+    std::decay_t<FoldF> Fold;
+    std::decay_t<MergeF> Merge;
+    std::vector<std::unique_ptr<Shard>> Shards;
+    std::atomic_size_t Remaining;
+  };
+
+  if (promises.empty()) {
+    return Promise<AccT>::Immediate(std::move(init));
+  }
+
+  size_t num_shards = std::thread::hardware_concurrency();
+  if (num_shards == 0) num_shards = 1;
+
+  auto rsl = Promise<AccT>::Create();
+  auto state = std::make_shared<State>(
+      std::move(init), std::forward<FoldF>(fold_fn),
+      std::forward<MergeF>(merge_fn),
+      promises.size(), num_shards);
+
+  for (const auto& promise : promises) {
+    promise->consume(
+        [rsl, state](T val) {
+          size_t shard_idx = std::hash<std::thread::id>{}(
+                                 std::this_thread::get_id()) %
+                             state->Shards.size();
+          Shard& shard = *state->Shards[shard_idx];
+          {
+            std::lock_guard l(shard.MPartial);
+            state->Fold(shard.Partial, std::move(val));
+          }
+
+          if (state->Remaining.fetch_sub(1) != 1) {
+            return;
+          }
+
+          // Last fold - every other fold has released its shard by now
+          AccT final_value = std::move(state->Init);
+          for (auto& s : state->Shards) {
+            std::lock_guard l(s->MPartial);
+            state->Merge(final_value, std::move(s->Partial));
+          }
+          rsl->resolve(std::move(final_value));
+        },
+        execution_context);
+  }
+
+  return rsl;
+}
+
+}  // namespace igasync
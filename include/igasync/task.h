@@ -1,6 +1,9 @@
 #ifndef IGASYNC_TASK_H
 #define IGASYNC_TASK_H
 
+#include <igasync/task_label.h>
+#include <igasync/trace_recorder.h>
+
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -28,18 +31,54 @@ class Task {
   template <class F, class... Args>
   static std::unique_ptr<Task> Of(F&& f, Args&&... args);
 
+  /**
+   * @brief Create a task attributed to the given label, for profiling
+   */
+  template <class F, class... Args>
+  static std::unique_ptr<Task> Labeled(TaskLabel label, F&& f, Args&&... args);
+
+  /**
+   * @brief Create a task that runs a continuation of the given promise, so
+   *        that dependency recording can link promises resolved by the task
+   *        back to it
+   */
+  template <class F>
+  static std::unique_ptr<Task> Continuation(const void* source_promise,
+                                            TaskLabel label, F&& f);
+
   void mark_scheduled();
   void run();
 
+  /**
+   * @brief Time of the most recent mark_scheduled() call
+   */
+  std::chrono::high_resolution_clock::time_point scheduled_at() const;
+
+  const TaskLabel& label() const;
+
+  /**
+   * @brief Promise whose resolution scheduled this task, if any
+   */
+  const void* source_promise() const;
+
  private:
+  friend class DependencyRecorder;
+
+  /**
+   * @brief Task running on the calling thread - only tracked while the
+   *        DependencyRecorder is recording
+   */
+  static const Task* current();
+
   Task(std::function<void()>&& fn,
-       std::function<void(TaskProfile)> profile_cb = nullptr)
-      : fn_(fn), profile_cb_(std::move(profile_cb)) {
-    profile_data_.Created = std::chrono::high_resolution_clock::now();
-  }
+       std::function<void(TaskProfile)> profile_cb = nullptr,
+       TaskLabel label = TaskLabel(nullptr, std::source_location()));
   std::function<void()> fn_;
   std::function<void(TaskProfile)> profile_cb_;
   TaskProfile profile_data_;
+  TaskTraceIds trace_ids_;
+  TaskLabel label_;
+  const void* source_promise_;
 };
 
 #include <igasync/task.inl>
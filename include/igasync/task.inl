@@ -16,3 +16,19 @@ std::unique_ptr<Task> Task::Of(F&& f, Args&&... args) {
       std::bind(std::forward<F>(f), std::forward<Args>(args)...);
   return std::unique_ptr<Task>(new Task(std::move(fn)));
 }
+
+template <class F, class... Args>
+std::unique_ptr<Task> Task::Labeled(TaskLabel label, F&& f, Args&&... args) {
+  std::function<void()> fn =
+      std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+  return std::unique_ptr<Task>(new Task(std::move(fn), nullptr, label));
+}
+
+template <class F>
+std::unique_ptr<Task> Task::Continuation(const void* source_promise,
+                                         TaskLabel label, F&& f) {
+  auto task = std::unique_ptr<Task>(
+      new Task(std::function<void()>(std::forward<F>(f)), nullptr, label));
+  task->source_promise_ = source_promise;
+  return task;
+}
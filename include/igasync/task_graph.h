@@ -0,0 +1,127 @@
+#ifndef IGASYNC_TASK_GRAPH_H
+#define IGASYNC_TASK_GRAPH_H
+
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Dependency graph of tasks that is declared once and executed many
+ *        times (e.g. once per frame).
+ *
+ * Nodes and edges are added up front, then compiled into a flat,
+ * topologically sorted array with one atomic dependency counter per node.
+ * Each execution resets the counters in O(nodes) and schedules the root nodes;
+ * a finishing node decrements its successors and runs the first one that
+ * becomes ready inline, scheduling only the rest. Nothing about the graph
+ * structure is allocated per execution - only the Task wrappers handed to the
+ * execution context and the returned promise.
+ *
+ * Nodes and edges must not be added while an execution is running, and only
+ * one execution may run at a time.
+ *
+ * @code{.cc}
+ * auto frame = TaskGraph::Create();
+ * auto input = frame->add_node([]() { poll_input(); });
+ * auto physics = frame->add_node([]() { step_physics(); });
+ * auto anim = frame->add_node([]() { update_animations(); });
+ * auto render = frame->add_node([]() { build_draw_lists(); });
+ * frame->add_edge(input, physics);
+ * frame->add_edge(input, anim);
+ * frame->add_edge(physics, render);
+ * frame->add_edge(anim, render);
+ *
+ * // Every tick:
+ * frame->execute(frame_async_tasks)->on_resolve(present, main_thread_tasks);
+ * @endcode
+ */
+class TaskGraph : public std::enable_shared_from_this<TaskGraph> {
+ public:
+  using NodeId = uint32_t;
+
+ public:
+  static std::shared_ptr<TaskGraph> Create();
+
+  TaskGraph(const TaskGraph&) = delete;
+  TaskGraph(TaskGraph&&) = delete;
+  TaskGraph& operator=(const TaskGraph&) = delete;
+  TaskGraph& operator=(TaskGraph&&) = delete;
+
+  /**
+   * @brief Declare a node that runs fn once per execution
+   * @return Identifier for the node, used to declare edges
+   */
+  NodeId add_node(std::function<void()> fn);
+
+  /**
+   * @brief Declare that node "after" may only start once node "before" has
+   *        finished, in every execution
+   */
+  void add_edge(NodeId before, NodeId after);
+
+  /**
+   * @brief Sort the declared nodes and build the flat execution layout. Called
+   *        automatically by execute() if the graph changed since the last
+   *        compile.
+   * @return False if the declared edges contain a cycle
+   */
+  bool compile();
+
+  /**
+   * @brief Run every node of the graph once, respecting declared edges
+   * @param execution_context Scheduler for graph nodes
+   * @return Promise that resolves once every node has finished, or nullptr if
+   *         the graph has a cycle or the previous execution is still running
+   */
+  std::shared_ptr<Promise<void>> execute(
+      std::shared_ptr<ExecutionContext> execution_context);
+
+  /**
+   * @return True while an execution has nodes that have not finished
+   */
+  bool is_running() const;
+
+  size_t node_count() const;
+
+ private:
+  TaskGraph();
+
+  struct NodeDecl {
+    std::function<void()> Fn;
+    std::vector<NodeId> Successors;
+  };
+
+  struct CompiledNode {
+    std::function<void()>* Fn;
+    uint32_t DependencyCount;
+    uint32_t SuccessorsBegin;
+    uint32_t SuccessorsEnd;
+  };
+
+  void run_from(uint32_t node_idx,
+                const std::shared_ptr<ExecutionContext>& execution_context,
+                const std::shared_ptr<Promise<void>>& done);
+
+ private:
+  mutable std::mutex m_graph_;
+  std::vector<NodeDecl> decls_;
+  bool is_compiled_;
+
+  std::vector<CompiledNode> nodes_;
+  std::vector<uint32_t> successors_;
+  std::vector<uint32_t> roots_;
+  std::unique_ptr<std::atomic_uint32_t[]> pending_dependencies_;
+  std::atomic_size_t remaining_nodes_;
+};
+
+}  // namespace igasync
+
+#endif
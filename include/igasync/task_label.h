@@ -0,0 +1,37 @@
+#ifndef IGASYNC_TASK_LABEL_H
+#define IGASYNC_TASK_LABEL_H
+
+#include <source_location>
+
+namespace igasync {
+
+/**
+ * @brief Static description of the code that produced a task - an optional
+ *        name plus the source location of the call that scheduled it.
+ *
+ * Functions that accept a TaskLabel default it, which captures the caller's
+ * source location at compile time. Passing a string literal instead names
+ * the task as well:
+ *
+ * @code{.cc}
+ * mesh_promise->then(upload_mesh, main_thread_tasks);
+ * mesh_promise->then(upload_mesh, main_thread_tasks, "upload mesh");
+ * @endcode
+ *
+ * Labels only hold pointers to static data, so they are cheap to copy and
+ * cost nothing at run time unless a profiler reads them.
+ */
+struct TaskLabel {
+  TaskLabel(const char* name = nullptr,
+            std::source_location location =
+                std::source_location::current()) noexcept
+      : Name(name), Location(location) {}
+
+  /** Must point to a string that outlives the task (e.g. a literal) */
+  const char* Name;
+  std::source_location Location;
+};
+
+}  // namespace igasync
+
+#endif
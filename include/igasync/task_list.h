@@ -3,10 +3,13 @@
 
 #include <concurrentqueue.h>
 #include <igasync/execution_context.h>
+#include <igasync/metrics.h>
 #include <igasync/promise.h>
 #include <igasync/task.h>
 
+#include <atomic>
 #include <shared_mutex>
+#include <string>
 
 namespace igasync {
 
@@ -19,6 +22,16 @@ namespace igasync {
 class ITaskScheduledListener {
  public:
   virtual void on_task_added() = 0;
+
+  /**
+   * @brief Notification for a batch of tasks added with one schedule_bulk
+   *        call. Defaults to one on_task_added() per task.
+   */
+  virtual void on_tasks_added(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      on_task_added();
+    }
+  }
 };
 
 /**
@@ -42,6 +55,25 @@ class TaskList : public ExecutionContext {
      * @brief Hint for the initial size of task listener store
      */
     size_t EnqueueListenerSizeHint{1};
+
+    /**
+     * @brief Human-readable name, used to label this list's tasks in traces
+     */
+    std::string Name{"TaskList"};
+
+    /**
+     * @brief Count enqueued/dequeued tasks and record schedule-to-start and
+     *        run time histograms, reported by metrics(). Costs two clock reads
+     *        and a few relaxed atomic adds per task.
+     */
+    bool CollectMetrics{false};
+
+    /**
+     * @brief Create readiness_fd(), so that an external event loop can block
+     *        in epoll/poll until this list has tasks. Linux only - ignored
+     *        elsewhere.
+     */
+    bool UseReadinessFd{false};
   };
 
  public:
@@ -57,29 +89,50 @@ class TaskList : public ExecutionContext {
    */
   static std::shared_ptr<TaskList> Create(Desc desc = Desc());
 
+  ~TaskList();
+
   /**
    * @brief Add a task to this task list, to be executed later
    * @param task Task to execute at some point in the future
    */
   virtual void schedule(std::unique_ptr<Task> task) override;
 
+  /**
+   * @brief Add several tasks with a single queue operation, notifying each
+   *        listener once for the whole batch
+   */
+  virtual void schedule_bulk(std::vector<std::unique_ptr<Task>> tasks) override;
+
   /**
    * @brief Schedule a task, and return a promise containing the result
    */
   template <typename F, typename... Args>
+    requires(!std::convertible_to<F, TaskLabel>)
   auto run(F&& f, Args&&... args)
       -> std::shared_ptr<Promise<std::invoke_result_t<F, Args...>>> {
+    return run(TaskLabel(nullptr, std::source_location()), std::forward<F>(f),
+               std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Schedule a task attributed to the given label (e.g. a string
+   *        literal naming it) for profiling, and return a promise containing
+   *        the result
+   */
+  template <typename F, typename... Args>
+  auto run(TaskLabel label, F&& f, Args&&... args)
+      -> std::shared_ptr<Promise<std::invoke_result_t<F, Args...>>> {
     using ValT = std::invoke_result_t<F, Args...>;
-    auto promise = Promise<ValT>::Create();
+    auto promise = Promise<ValT>::Create(label.Location);
 
     if constexpr (std::same_as<ValT, void>) {
-      schedule(Task::Of([promise, f, args...] {
+      schedule(Task::Labeled(label, [promise, f, args...] {
         f(args...);
         promise->resolve();
       }));
     } else {
-      schedule(
-          Task::Of([promise, f, args...] { promise->resolve(f(args...)); }));
+      schedule(Task::Labeled(
+          label, [promise, f, args...] { promise->resolve(f(args...)); }));
     }
     return promise;
   }
@@ -104,11 +157,54 @@ class TaskList : public ExecutionContext {
    */
   void unregister_listener(std::shared_ptr<ITaskScheduledListener> listener);
 
+  const std::string& name() const;
+
+  /**
+   * @brief Pollable eventfd that becomes readable when tasks are scheduled,
+   *        and is reset once execute_next() finds the list empty.
+   *
+   * Only the first task scheduled after a reset writes to the eventfd, so a
+   * burst of tasks wakes the event loop once, and scheduling costs a single
+   * atomic exchange while the list is already signaled. Drain the list (call
+   * execute_next() until it returns false) after each wakeup - each call that
+   * finds the list empty reads the eventfd to reset it.
+   *
+   * @return The eventfd, or -1 if Desc::UseReadinessFd was not set or is not
+   *         supported. Owned by this list - do not close it.
+   */
+  int readiness_fd() const;
+
+  /**
+   * @brief Snapshot of queue depth and, if Desc::CollectMetrics was set,
+   *        throughput counters and latency histograms. Safe to call from any
+   *        thread while tasks are running.
+   */
+  TaskListMetrics metrics() const;
+
  private:
   TaskList(Desc desc);
 
+  void run_task(Task& task);
+
+  void signal_readiness();
+  void reset_readiness();
+
+  std::string name_;
+  uint32_t trace_id_;
   moodycamel::ConcurrentQueue<std::unique_ptr<Task>> tasks_;
 
+  // Only allocated if metrics are enabled
+  struct Counters {
+    std::atomic_uint64_t Enqueued{0};
+    std::atomic_uint64_t Dequeued{0};
+    LatencyHistogram ScheduleToStart;
+    LatencyHistogram RunTime;
+  };
+  std::unique_ptr<Counters> counters_;
+
+  int readiness_fd_;
+  std::atomic_bool is_readiness_signaled_;
+
   std::shared_mutex m_enqueue_listeners_;
   std::vector<std::shared_ptr<ITaskScheduledListener>> enqueue_listeners_;
 };
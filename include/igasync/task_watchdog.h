@@ -0,0 +1,152 @@
+#ifndef IGASYNC_TASK_WATCHDOG_H
+#define IGASYNC_TASK_WATCHDOG_H
+
+#include <igasync/task_label.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Description of a task that has been running for longer than a
+ *        TaskWatchdog threshold
+ */
+struct StalledTask {
+  std::thread::id ThreadId{};
+
+  /** Label of the stalled task (may be empty) */
+  const char* Name{nullptr};
+  const char* File{""};
+  uint32_t Line{0};
+
+  /**
+   * Name of the TaskList the task was pulled from (empty if the TaskList was
+   * destroyed before the stall was reported)
+   */
+  std::string TaskListName;
+
+  /** How long the task had been running when it was noticed */
+  std::chrono::nanoseconds RunningFor{0};
+};
+
+/**
+ * @brief Background thread that reports TaskList tasks running for longer
+ *        than a threshold - e.g. a task that blocks a thread pool worker, or
+ *        holds up the main thread task list for a whole frame.
+ *
+ * While any watchdog exists, every thread running TaskList tasks publishes
+ * the start time and label of its current task to its own cache line, which
+ * the watchdog thread polls. Task execution never takes a lock or writes
+ * memory shared with another thread.
+ *
+ * Each stalled task is reported once, from the watchdog thread. The callback
+ * runs while the task is still stalled, so it can be used to capture the
+ * stalled thread's stack.
+ *
+ * @code{.cc}
+ * TaskWatchdog::Desc desc;
+ * desc.Threshold = std::chrono::milliseconds(8);
+ * desc.OnStall = [](const StalledTask& t) { log_hitch(t); };
+ * auto watchdog = TaskWatchdog::Create(desc);
+ * @endcode
+ */
+class TaskWatchdog {
+ public:
+  /**
+   * @brief Describes all parameters used to construct a TaskWatchdog, with
+   *        reasonable defaults.
+   */
+  struct Desc {
+    Desc() noexcept {}
+
+    /** Tasks running for longer than this are reported */
+    std::chrono::nanoseconds Threshold{std::chrono::milliseconds(50)};
+
+    /** How often the watchdog thread checks running tasks */
+    std::chrono::nanoseconds PollInterval{std::chrono::milliseconds(5)};
+
+    /** Invoked on the watchdog thread for each stalled task */
+    std::function<void(const StalledTask&)> OnStall{};
+
+    /** Number of most recent stalls kept for stalls() */
+    size_t HistorySize{64};
+  };
+
+  /**
+   * @brief What a thread was running before begin_task, restored by end_task
+   */
+  struct TaskState {
+    int64_t StartedNs{0};
+    const char* Name{nullptr};
+    const char* File{""};
+    uint32_t Line{0};
+    uint32_t TaskListId{0};
+
+    /** Identifies one run of a task, so that each stall is reported once */
+    uint64_t Serial{0};
+  };
+
+ public:
+  static std::shared_ptr<TaskWatchdog> Create(Desc desc = Desc());
+  ~TaskWatchdog();
+
+  TaskWatchdog(const TaskWatchdog&) = delete;
+  TaskWatchdog(TaskWatchdog&&) = delete;
+  TaskWatchdog& operator=(const TaskWatchdog&) = delete;
+  TaskWatchdog& operator=(TaskWatchdog&&) = delete;
+
+  /**
+   * @return Most recently reported stalls, oldest first
+   */
+  std::vector<StalledTask> stalls() const;
+
+  /**
+   * @brief True while any watchdog exists - checked before publishing tasks
+   */
+  static bool is_watching() {
+    return watchdog_count_.load(std::memory_order_relaxed) > 0;
+  }
+
+  /**
+   * @brief Publish the task the calling thread is about to run
+   * @return State to pass to end_task once the task finishes
+   */
+  static TaskState begin_task(const TaskLabel& label, uint32_t task_list_id);
+  static void end_task(const TaskState& outer);
+
+  /** Per-thread published task (implementation detail) */
+  struct Slot;
+
+ private:
+  TaskWatchdog(Desc desc);
+  void watch();
+
+  static Slot& this_thread_slot();
+
+ private:
+  static std::atomic_int watchdog_count_;
+
+  Desc desc_;
+
+  std::mutex m_stop_;
+  std::condition_variable cv_stop_;
+  bool is_stopping_;
+
+  mutable std::mutex m_stalls_;
+  std::vector<StalledTask> stalls_;
+
+  std::thread thread_;
+};
+
+}  // namespace igasync
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef IGASYNC_THREAD_POOL_H
 #define IGASYNC_THREAD_POOL_H
 
+#include <igasync/metrics.h>
 #include <igasync/task_list.h>
 
 #include <atomic>
@@ -47,15 +48,32 @@ class ThreadPool : public std::enable_shared_from_this<ThreadPool>,
 
   std::vector<std::thread::id> thread_ids() const;
 
+  /**
+   * @brief Snapshot of per-worker activity. Busy and idle time are updated
+   *        each time a worker parks or wakes up, so a worker that has been
+   *        busy (or asleep) for a long stretch lags behind until it switches.
+   */
+  ThreadPoolMetrics metrics() const;
+
   // ITaskScheduledListener
   virtual void on_task_added() override;
+  virtual void on_tasks_added(size_t count) override;
 
  private:
   ThreadPool(Desc desc);
 
+  // Written only by the owning worker, padded to avoid false sharing
+  struct alignas(64) WorkerCounters {
+    std::atomic_uint64_t TasksExecuted{0};
+    std::atomic_uint64_t Parks{0};
+    std::atomic_int64_t BusyNs{0};
+    std::atomic_int64_t IdleNs{0};
+  };
+
  private:
   std::atomic_bool is_cancelled_;
   std::vector<std::thread> threads_;
+  std::unique_ptr<WorkerCounters[]> worker_counters_;
   std::atomic_size_t next_task_list_idx_;
 
   std::shared_mutex m_task_lists_;
@@ -0,0 +1,216 @@
+#ifndef IGASYNC_TIMER_WHEEL_H
+#define IGASYNC_TIMER_WHEEL_H
+
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Schedules tasks to run after a delay, or at a point in time.
+ *
+ * Timers are kept in a hierarchical timing wheel: 11 levels of 64 slots,
+ * where each level's slots cover 64x the time of the level below. Adding and
+ * cancelling a timer is O(1) no matter how many are pending, and timers are
+ * stored in one reusable array, so keeping a million timers (e.g. a cooldown
+ * per entity) costs no allocation beyond the tasks themselves. Timers are
+ * rounded up to Desc::Resolution, and never fire early.
+ *
+ * Due tasks are handed to their execution contexts from one thread - the
+ * timer thread, or whoever calls advance() - with one schedule_bulk call per
+ * context, per tick.
+ *
+ * A delay() raced against another promise with when_any makes a timeout:
+ *
+ * @code{.cc}
+ * auto timers = TimerWheel::Create();
+ * // Resolves with 1 if the upload takes longer than two seconds
+ * auto winner = when_any(
+ *     {upload_save(), timers->delay(std::chrono::seconds(2), main_tasks)},
+ *     main_tasks);
+ *
+ * auto cooldown = timers->schedule_after(
+ *     std::chrono::milliseconds(1500),
+ *     Task::Of([entity]() { entity->reset_cooldown(); }), game_tasks);
+ * // ...
+ * timers->cancel(cooldown);
+ * @endcode
+ */
+class TimerWheel {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /** Identifies a scheduled timer for cancel(). Never 0. */
+  using TimerId = uint64_t;
+
+  /**
+   * @brief Describes all parameters used to construct a TimerWheel, with
+   *        reasonable defaults.
+   */
+  struct Desc {
+    Desc() noexcept {}
+
+    /** Length of one tick. Timers are rounded up to a whole tick. */
+    std::chrono::nanoseconds Resolution{std::chrono::milliseconds(1)};
+
+    /**
+     * Fire timers from a thread owned by the wheel. If false, timers only
+     * fire when advance() is called.
+     */
+    bool UseDedicatedThread{true};
+
+    /** Timers to make room for up front */
+    size_t CapacityHint{64};
+
+    /** Name of the timer thread reported to the TraceRecorder */
+    std::string Name{"igasync timer"};
+  };
+
+ public:
+  static std::shared_ptr<TimerWheel> Create(Desc desc = Desc());
+
+  /**
+   * @brief Process-wide wheel with default parameters, used by delay().
+   *        Created on first use.
+   */
+  static std::shared_ptr<TimerWheel> Default();
+
+  /**
+   * @brief Stops the timer thread. Pending timers never fire.
+   */
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel(TimerWheel&&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  TimerWheel& operator=(TimerWheel&&) = delete;
+
+  /**
+   * @brief Schedule task on execution_context once delay has passed
+   * @param execution_context Where the task is scheduled once due. If null,
+   *        the task runs on the thread firing timers, which holds up every
+   *        other timer while it runs.
+   */
+  TimerId schedule_after(
+      Clock::duration delay, std::unique_ptr<Task> task,
+      std::shared_ptr<ExecutionContext> execution_context = nullptr);
+
+  /**
+   * @brief Schedule task on execution_context once time has been reached
+   */
+  TimerId schedule_at(
+      Clock::time_point time, std::unique_ptr<Task> task,
+      std::shared_ptr<ExecutionContext> execution_context = nullptr);
+
+  /**
+   * @brief Promise that resolves on execution_context once delay has passed
+   */
+  std::shared_ptr<Promise<void>> delay(
+      Clock::duration delay,
+      std::shared_ptr<ExecutionContext> execution_context = nullptr);
+
+  /**
+   * @brief Stop a timer from firing, and destroy its task
+   * @return False if the timer already fired (or was cancelled)
+   */
+  bool cancel(TimerId timer);
+
+  /**
+   * @brief Fire every timer due at or before now. Called by the timer thread
+   *        if there is one.
+   * @return Number of timers fired
+   */
+  size_t advance(Clock::time_point now = Clock::now());
+
+  /**
+   * @return Time at which the wheel next needs to advance, if any timer is
+   *         pending. May be earlier than the next timer, for far off timers
+   *         that move to a finer level of the wheel first.
+   */
+  std::optional<Clock::time_point> next_wakeup() const;
+
+  size_t pending_count() const;
+
+ private:
+  TimerWheel(Desc desc);
+
+  static constexpr uint32_t kLevels = 11;
+  static constexpr uint32_t kSlotsPerLevel = 64;
+  static constexpr uint32_t kSlotBits = 6;
+  static constexpr uint32_t kNil = 0xFFFFFFFF;
+
+  struct Timer {
+    uint64_t Tick{0};
+    uint32_t Prev{kNil};
+    uint32_t Next{kNil};
+
+    /** Bumped whenever the timer is freed, so stale TimerIds do nothing */
+    uint32_t Generation{1};
+    uint8_t Level{0};
+    uint8_t Slot{0};
+    bool IsPending{false};
+
+    std::unique_ptr<Task> Fire;
+    std::shared_ptr<ExecutionContext> Context;
+  };
+
+  uint64_t tick_at(Clock::time_point time, bool round_up) const;
+  Clock::time_point time_at(uint64_t tick) const;
+
+  struct SlotRef {
+    uint64_t Tick;
+    uint32_t Level;
+    uint32_t Slot;
+  };
+
+  /** Requires m_wheel_. Files the timer under the level its tick falls in. */
+  void link(uint32_t idx);
+  /** Requires m_wheel_ */
+  void unlink(uint32_t idx);
+  /** Requires m_wheel_. Returns the timer to the free list. */
+  void release(uint32_t idx);
+  /** Requires m_wheel_. Earliest non-empty slot, and when it is due. */
+  std::optional<SlotRef> next_slot() const;
+
+  void run_thread();
+
+ private:
+  Desc desc_;
+  Clock::time_point start_;
+
+  mutable std::mutex m_wheel_;
+  uint64_t now_tick_;
+  std::vector<Timer> timers_;
+  std::vector<uint32_t> free_timers_;
+  uint32_t slot_heads_[kLevels][kSlotsPerLevel];
+  uint64_t occupied_slots_[kLevels];
+  size_t pending_count_;
+
+  /** Tick the timer thread is sleeping until, UINT64_MAX if unbounded */
+  uint64_t wake_tick_;
+  std::condition_variable cv_wake_;
+  bool is_stopping_;
+  std::thread timer_thread_;
+};
+
+/**
+ * @brief Promise that resolves on execution_context once delay has passed,
+ *        using the process-wide TimerWheel::Default() wheel
+ */
+std::shared_ptr<Promise<void>> delay(
+    TimerWheel::Clock::duration delay,
+    std::shared_ptr<ExecutionContext> execution_context = nullptr);
+
+}  // namespace igasync
+
+#endif
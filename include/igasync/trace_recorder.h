@@ -0,0 +1,194 @@
+#ifndef IGASYNC_TRACE_RECORDER_H
+#define IGASYNC_TRACE_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Identifiers a Task carries so the trace recorder can draw flow arrows
+ *        between the task that created it (e.g. by resolving a promise) and
+ *        the task itself. All zero when tracing was off at creation.
+ */
+struct TaskTraceIds {
+  uint64_t TaskId{0};
+  uint64_t ParentTaskId{0};
+  uint32_t CreatorThread{0};
+};
+
+/**
+ * @brief Process-wide recorder of task executions, exported as Chrome Trace
+ *        Event JSON (loadable in ui.perfetto.dev or chrome://tracing).
+ *
+ * Every thread that runs a task while recording writes into its own
+ * fixed-size ring buffer, so recording threads never contend with each other
+ * - the oldest events on a thread are overwritten once its buffer is full.
+ *
+ * Each task shows up as a slice on the track of the thread that ran it, named
+ * after the TaskList it was pulled from. A flow arrow links every task to the
+ * task that was running when it was created - for promise continuations, that
+ * is the task that resolved the promise.
+ *
+ * @code{.cc}
+ * TraceRecorder::Get().start();
+ * run_some_frames();
+ * TraceRecorder::Get().stop();
+ *
+ * std::ofstream fout("frames.json");
+ * TraceRecorder::Get().write_json(fout);
+ * @endcode
+ */
+class TraceRecorder {
+ public:
+  /**
+   * @brief Global recorder instance
+   */
+  static TraceRecorder& Get();
+
+  /**
+   * @brief Cheap check used on hot paths before doing any tracing work
+   */
+  static bool is_recording() {
+    return is_recording_.load(std::memory_order_relaxed);
+  }
+
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder(TraceRecorder&&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(TraceRecorder&&) = delete;
+
+  /**
+   * @brief Discard previously recorded events and start recording
+   * @param events_per_thread Ring buffer capacity for each recording thread
+   */
+  void start(size_t events_per_thread = 16384);
+
+  /**
+   * @brief Stop recording. Recorded events are kept until the next start().
+   */
+  void stop();
+
+  /**
+   * @brief Write every recorded event as Chrome Trace Event JSON. Intended to
+   *        be called after stop() - events from tasks that finish while this
+   *        runs may or may not be included.
+   */
+  void write_json(std::ostream& out);
+
+  /**
+   * @brief Convenience wrapper around write_json
+   */
+  std::string to_json();
+
+  /**
+   * @brief Name the track of the calling thread in exported traces
+   */
+  void set_thread_name(std::string name);
+
+  /**
+   * @brief Register a TaskList name, returning the identifier TaskLists use to
+   *        tag the tasks they execute
+   */
+  uint32_t register_task_list(std::string name);
+
+  /**
+   * @brief Forget a destroyed TaskList's name. Names of lists destroyed while
+   *        recording are kept (for write_json) until the next start().
+   */
+  void unregister_task_list(uint32_t task_list_id);
+
+  /**
+   * @brief Name a TaskList was registered with (empty if unknown, or if the
+   *        TaskList has been destroyed and its name is no longer kept)
+   */
+  std::string task_list_name(uint32_t task_list_id);
+
+  /**
+   * @brief Set the TaskList the calling thread is currently executing tasks
+   *        from (0 for none). Returns the previous value.
+   */
+  static uint32_t set_current_task_list(uint32_t task_list_id);
+
+  /**
+   * @brief Identifiers for a task being created on the calling thread
+   */
+  TaskTraceIds on_task_created();
+
+  /**
+   * @brief Mark a task as running on the calling thread (for flow arrows from
+   *        tasks it creates). Returns the previously running task.
+   */
+  static uint64_t set_current_task(uint64_t task_id);
+
+  /**
+   * @brief Record one finished task execution on the calling thread's buffer
+   */
+  void record_task(const TaskTraceIds& ids,
+                   std::chrono::high_resolution_clock::time_point created,
+                   std::chrono::high_resolution_clock::time_point scheduled,
+                   std::chrono::high_resolution_clock::time_point started,
+                   std::chrono::high_resolution_clock::time_point finished);
+
+ private:
+  TraceRecorder();
+
+  // Seqlock-protected event slot - every field is atomic so that a reader
+  // racing with the owning thread sees a torn slot (and skips it) instead of
+  // undefined behavior.
+  struct EventSlot {
+    std::atomic_uint64_t Seq{0};
+    std::atomic_uint64_t TaskId{0};
+    std::atomic_uint64_t ParentTaskId{0};
+    std::atomic_uint64_t CreatorThread{0};
+    std::atomic_uint64_t TaskListId{0};
+    std::atomic_int64_t CreatedNs{0};
+    std::atomic_int64_t ScheduledNs{0};
+    std::atomic_int64_t StartedNs{0};
+    std::atomic_int64_t FinishedNs{0};
+  };
+
+  struct ThreadTrack {
+    uint32_t ThreadIdx;
+    std::string Name;
+
+    // Written only by the owning thread
+    std::unique_ptr<EventSlot[]> Slots;
+    size_t Capacity{0};
+    std::atomic_uint64_t WriteIdx{0};
+    std::atomic_uint64_t Generation{0};
+  };
+
+  ThreadTrack& this_thread_track();
+
+  // Live or retired TaskList name, m_tracks_ must be held
+  const std::string* find_task_list_name(uint32_t task_list_id) const;
+  int64_t to_ns(std::chrono::high_resolution_clock::time_point t) const;
+
+ private:
+  static std::atomic_bool is_recording_;
+
+  std::atomic_uint64_t next_task_id_;
+  std::atomic_uint32_t next_task_list_id_;
+  std::atomic_uint64_t generation_;
+  std::atomic_size_t events_per_thread_;
+  std::atomic<std::chrono::high_resolution_clock::rep> epoch_;
+
+  std::mutex m_tracks_;
+  std::vector<std::shared_ptr<ThreadTrack>> tracks_;
+  std::unordered_map<uint32_t, std::string> task_list_names_;
+
+  // Destroyed while recording - events may still reference them
+  std::unordered_map<uint32_t, std::string> retired_task_list_names_;
+};
+
+}  // namespace igasync
+
+#endif
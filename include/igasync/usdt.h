@@ -0,0 +1,50 @@
+#ifndef IGASYNC_USDT_H
+#define IGASYNC_USDT_H
+
+/**
+ * Linux USDT (user-level statically defined tracing) probes, visible to perf,
+ * bpftrace, BCC and SystemTap under the "igasync" provider.
+ *
+ * Probes are only compiled in if the library (and everything including its
+ * headers) is built with IGASYNC_ENABLE_USDT=1 - set by the CMake option of
+ * the same name when sys/sdt.h is available. An inactive probe is a single
+ * nop instruction and there is no runtime library dependency. Otherwise the
+ * macros expand to nothing.
+ *
+ * Probes (arguments in order):
+ *   task_list__schedule  task, task list, task list name
+ *   task__start          task, task list
+ *   task__end            task, task list
+ *   promise__resolve     promise
+ *   combiner__complete   promise combiner, number of combined promises
+ *   worker__park         thread pool, worker index
+ *   worker__unpark       thread pool, worker index
+ *
+ * For example, to get a histogram of schedule-to-start latency:
+ *
+ * @code
+ * bpftrace -e '
+ *   usdt:./game:igasync:task_list__schedule { @s[arg0] = nsecs; }
+ *   usdt:./game:igasync:task__start /@s[arg0]/ {
+ *     @wait_us = hist((nsecs - @s[arg0]) / 1000); delete(@s[arg0]);
+ *   }'
+ * @endcode
+ */
+
+#ifndef IGASYNC_ENABLE_USDT
+#define IGASYNC_ENABLE_USDT 0
+#endif
+
+#if IGASYNC_ENABLE_USDT && defined(__linux__)
+#include <sys/sdt.h>
+
+#define IGASYNC_PROBE1(name, a) DTRACE_PROBE1(igasync, name, a)
+#define IGASYNC_PROBE2(name, a, b) DTRACE_PROBE2(igasync, name, a, b)
+#define IGASYNC_PROBE3(name, a, b, c) DTRACE_PROBE3(igasync, name, a, b, c)
+#else
+#define IGASYNC_PROBE1(name, a) ((void)0)
+#define IGASYNC_PROBE2(name, a, b) ((void)0)
+#define IGASYNC_PROBE3(name, a, b, c) ((void)0)
+#endif
+
+#endif
@@ -5,24 +5,30 @@ namespace igasync {
 template <typename F>
   requires(VoidPromiseThenCb<F>)
 std::shared_ptr<Promise<void>> Promise<void>::on_resolve(
-    F&& f, std::shared_ptr<ExecutionContext> execution_context) {
+    F&& f, std::shared_ptr<ExecutionContext> execution_context,
+    TaskLabel label) {
   std::lock_guard l(m_then_queue_);
 
   if (is_finished_) {
-    execution_context->schedule(Task::Of(f));
+    execution_context->schedule(Task::Continuation(this, label, f));
     return this->shared_from_this();
   }
 
-  then_queue_.emplace(ThenOp{std::move(f), std::move(execution_context)});
+  if (census_entry_ != nullptr) {
+    census_entry_->PendingContinuations++;
+    census_entry_->CapturedBytes += sizeof(F);
+  }
+  then_queue_.emplace(
+      ThenOp{std::move(f), std::move(execution_context), label});
   return this->shared_from_this();
 }
 
 template <typename F, typename RslT>
   requires(CanApplyFunctor<F>)
 auto Promise<void>::then(F&& f,
-                         std::shared_ptr<ExecutionContext> execution_context)
-    -> std::shared_ptr<Promise<RslT>> {
-  auto tr = Promise<RslT>::Create();
+                         std::shared_ptr<ExecutionContext> execution_context,
+                         TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
+  auto tr = Promise<RslT>::Create(label.Location);
 
   on_resolve(
       [tr, f = std::move(f)]() {
@@ -33,7 +39,7 @@ auto Promise<void>::then(F&& f,
           tr->resolve(f());
         }
       },
-      execution_context);
+      execution_context, label);
   return tr;
 }
 
@@ -41,13 +47,13 @@ template <typename F, typename RslT>
   requires(HasAppropriateFunctor<std::shared_ptr<Promise<RslT>>, F>)
 auto Promise<void>::then_chain(
     F&& f, std::shared_ptr<ExecutionContext> outer_execution_context,
-    std::shared_ptr<ExecutionContext> inner_execution_context_override)
-    -> std::shared_ptr<Promise<RslT>> {
+    std::shared_ptr<ExecutionContext> inner_execution_context_override,
+    TaskLabel label) -> std::shared_ptr<Promise<RslT>> {
   if (inner_execution_context_override == nullptr) {
     inner_execution_context_override = outer_execution_context;
   }
 
-  auto tr = Promise<RslT>::Create();
+  auto tr = Promise<RslT>::Create(label.Location);
   on_resolve(
       [tr, f = std::move(f), inner_execution_context_override]() {
         if constexpr (std::is_void_v<RslT>) {
@@ -58,7 +64,7 @@ auto Promise<void>::then_chain(
                        inner_execution_context_override);
         }
       },
-      outer_execution_context);
+      outer_execution_context, label);
   return tr;
 }
 
@@ -0,0 +1,117 @@
+#ifndef IGASYNC_WHEN_ANY_H
+#define IGASYNC_WHEN_ANY_H
+
+#include <igasync/concepts.h>
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace igasync {
+
+/**
+ * @brief Result of a when_any race over non-void promises
+ * @tparam T Value type of the raced promises
+ */
+template <typename T>
+struct WhenAnyResult {
+  /** Index (in the input list) of the promise that resolved first */
+  size_t Index;
+
+  /** Copy of the value held by the winning promise */
+  T Value;
+};
+
+/**
+ * @brief Execution context that decides the winner of a when_any race.
+ *
+ * Each raced promise gets its own RaceExecutionContext. The first one asked to
+ * schedule a task claims the race with a single CAS and forwards the task to
+ * the real execution context. Every later one runs the task inline instead of
+ * forwarding it - the racing callback is a no-op for losers, so all that runs
+ * is the promise bookkeeping, and nothing is ever enqueued on a TaskList on
+ * behalf of a losing branch.
+ *
+ * Internal to when_any, exposed only so the templates can see it.
+ */
+class RaceExecutionContext : public ExecutionContext {
+ public:
+  static constexpr size_t kNoWinner = std::numeric_limits<size_t>::max();
+
+  RaceExecutionContext(std::shared_ptr<std::atomic_size_t> winner,
+                       size_t index,
+                       std::shared_ptr<ExecutionContext> inner_context);
+
+  virtual void schedule(std::unique_ptr<Task> task) override;
+
+ private:
+  std::shared_ptr<std::atomic_size_t> winner_;
+  size_t index_;
+  std::shared_ptr<ExecutionContext> inner_context_;
+};
+
+/**
+ * @brief Result promise and on_lost callback of a when_any race, shared by
+ *        every branch. The winning branch takes both out, so that a losing
+ *        promise that never resolves does not keep them alive.
+ *
+ * Internal to when_any, exposed only so the templates can see it.
+ */
+template <typename ResultT>
+struct WhenAnyState {
+  std::shared_ptr<Promise<ResultT>> Result;
+  std::function<void(size_t)> OnLost;
+};
+
+/**
+ * @brief Create a promise that resolves with the index and value of whichever
+ *        input promise resolves first.
+ *
+ * Losing promises are not cancelled (igasync has no way to stop the work that
+ * produces them), but their when_any continuations are never scheduled onto
+ * the execution context. If the work itself can be stopped, pass on_lost - it
+ * is invoked once per losing index, on the execution context, right before the
+ * returned promise resolves.
+ *
+ * @code{.cc}
+ * auto asset = when_any<Mesh>({load_cached_mesh(), regenerate_mesh()},
+ *                             main_thread_tasks);
+ * @endcode
+ *
+ * An empty input list produces a promise that never resolves.
+ *
+ * Until a losing promise resolves, its continuation keeps a reference to the
+ * execution context, but not to the returned promise or on_lost.
+ *
+ * @param promises Promises to race
+ * @param execution_context Scheduler for the winning callback
+ * @param on_lost Optional callback invoked with each losing index
+ * @return A promise that resolves with the winner's index and value
+ */
+template <typename T>
+  requires(!IsVoid<T>)
+std::shared_ptr<Promise<WhenAnyResult<T>>> when_any(
+    const std::vector<std::shared_ptr<Promise<T>>>& promises,
+    std::shared_ptr<ExecutionContext> execution_context,
+    std::function<void(size_t)> on_lost = nullptr);
+
+/**
+ * @brief Create a promise that resolves with the index of whichever void
+ *        promise resolves first.
+ *
+ * Same semantics as the non-void overload.
+ */
+std::shared_ptr<Promise<size_t>> when_any(
+    const std::vector<std::shared_ptr<Promise<void>>>& promises,
+    std::shared_ptr<ExecutionContext> execution_context,
+    std::function<void(size_t)> on_lost = nullptr);
+
+}  // namespace igasync
+
+#include <igasync/when_any.inl>
+
+#endif
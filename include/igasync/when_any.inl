@@ -0,0 +1,44 @@
+#include <igasync/when_any.h>
+
+namespace igasync {
+
+template <typename T>
+  requires(!IsVoid<T>)
+std::shared_ptr<Promise<WhenAnyResult<T>>> when_any(
+    const std::vector<std::shared_ptr<Promise<T>>>& promises,
+    std::shared_ptr<ExecutionContext> execution_context,
+    std::function<void(size_t)> on_lost) {
+  auto rsl = Promise<WhenAnyResult<T>>::Create();
+  auto state = std::make_shared<WhenAnyState<WhenAnyResult<T>>>(
+      WhenAnyState<WhenAnyResult<T>>{rsl, std::move(on_lost)});
+  auto winner =
+      std::make_shared<std::atomic_size_t>(RaceExecutionContext::kNoWinner);
+  size_t num_promises = promises.size();
+
+  for (size_t i = 0; i < num_promises; i++) {
+    promises[i]->on_resolve(
+        [state, winner, i, num_promises](const T& v) {
+          if (winner->load() != i) {
+            return;
+          }
+
+          // Only the winner gets here, and only once
+          auto result = std::move(state->Result);
+          auto lost = std::move(state->OnLost);
+          if (lost) {
+            for (size_t j = 0; j < num_promises; j++) {
+              if (j != i) {
+                lost(j);
+              }
+            }
+          }
+
+          result->resolve(WhenAnyResult<T>{i, v});
+        },
+        std::make_shared<RaceExecutionContext>(winner, i, execution_context));
+  }
+
+  return rsl;
+}
+
+}  // namespace igasync
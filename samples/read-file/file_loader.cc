@@ -0,0 +1,910 @@
+#include "file_loader.h"
+
+#include <algorithm>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+namespace {
+using igasync::sample::FilePromise;
+using igasync::sample::FileReadError;
+
+FilePromise::result_t read_file_blocking(
+    const std::string& file_name, igasync::sample::ReadBufferPool* pool) {
+  std::ifstream fin(file_name, std::ios::binary | std::ios::ate);
+  if (!fin) {
+    return FileReadError::FileNotFound;
+  }
+
+  auto size = fin.tellg();
+  fin.seekg(0, std::ios::beg);
+
+  std::string data = pool ? pool->acquire(size) : std::string(size, '\0');
+  if (!fin.read(&data[0], size)) {
+    return FileReadError::FileNotRead;
+  }
+
+  return data;
+}
+
+igasync::sample::MappedFile::result_t map_file_blocking(
+    const std::string& file_name, igasync::sample::MappedFile::AccessHint hint) {
+#if defined(_WIN32)
+  // TODO (sessamekesh): Support memory mapped files on Windows
+  return FileReadError::FileNotRead;
+#else
+  int fd = ::open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return errno == ENOENT ? FileReadError::FileNotFound
+                           : FileReadError::FileNotRead;
+  }
+
+  auto rsl = igasync::sample::MappedFile::Map(fd, hint);
+  ::close(fd);
+  return rsl;
+#endif
+}
+
+template <typename ValT>
+void resolve_on(igasync::ExecutionContext* context,
+                std::shared_ptr<igasync::Promise<ValT>> promise, ValT val) {
+  if (context == nullptr) {
+    promise->resolve(std::move(val));
+    return;
+  }
+
+  context->schedule(igasync::Task::Of(
+      [promise = std::move(promise), val = std::move(val)]() mutable {
+        promise->resolve(std::move(val));
+      }));
+}
+
+#if defined(__linux__)
+// user_data of the eventfd read that wakes the I/O thread for new requests
+const uint64_t kWakeUserData = 0;
+
+// Largest single read - io_uring read lengths are 32 bits
+const size_t kMaxReadSize = 1u << 30;
+
+// Failed submits in a row (backing off between them) before the ring is
+// given up on in favor of the blocking fallback
+const uint32_t kMaxFailedSubmits = 8;
+
+// Longest wait for the kernel to finish operations of a failed ring
+const auto kFailedRingDrainTime = std::chrono::seconds(1);
+
+bool is_transient_submit_error(int err) {
+  return err == -EAGAIN || err == -EBUSY || err == -ENOMEM;
+}
+#endif
+}  // namespace
+
+namespace igasync::sample {
+
+std::shared_ptr<FileLoader> FileLoader::Create(FileLoader::Desc desc) {
+  return std::shared_ptr<FileLoader>(new FileLoader(desc));
+}
+
+FileLoader::FileLoader(FileLoader::Desc desc)
+    : desc_(desc), is_stopping_(false), outstanding_(0) {
+  if (desc_.MaxInFlight == 0) {
+    desc_.MaxInFlight = 1;
+  }
+
+#if defined(__linux__)
+  wake_fd_ = -1;
+  wake_value_ = 0;
+  is_ring_failed_ = false;
+  if (desc_.UseIoUring) {
+    // One entry per in-flight file (each has at most one pending operation),
+    // plus one for the wakeup read
+    ring_ = IoUring::Create(desc_.MaxInFlight + 1);
+    if (ring_ && !(ring_->supports(IORING_OP_OPENAT) &&
+                   ring_->supports(IORING_OP_READ))) {
+      ring_ = nullptr;
+    }
+    if (ring_) {
+      wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+      if (wake_fd_ < 0) {
+        ring_ = nullptr;
+      }
+    }
+  }
+
+  if (ring_) {
+    ring_thread_ = std::thread([this]() { run_ring(); });
+    return;
+  }
+#endif
+
+  fallback_pool_ = create_fallback_pool();
+}
+
+std::shared_ptr<BlockingPool> FileLoader::create_fallback_pool() const {
+  // Thread count of the fallback pool enforces the in-flight limit
+  BlockingPool::Desc pool_desc;
+  pool_desc.MaxThreads =
+      std::max(1u, std::min(desc_.FallbackThreadCount, desc_.MaxInFlight));
+  pool_desc.Name = "FileLoader";
+  return BlockingPool::Create(pool_desc);
+}
+
+FileLoader::~FileLoader() {
+#if defined(__linux__)
+  if (ring_) {
+    {
+      std::lock_guard l(m_pending_);
+      is_stopping_ = true;
+    }
+    uint64_t one = 1;
+    (void)::write(wake_fd_, &one, sizeof(one));
+    ring_thread_.join();
+  }
+#endif
+
+  // Finishing a load_many file submits the next one, so the pool can not be
+  // released until every request (issued or not) is done. A failed ring has
+  // handed its remaining requests to the pool.
+  {
+    std::unique_lock l(m_pending_);
+    cv_outstanding_.wait(l, [this]() { return outstanding_ == 0; });
+  }
+
+#if defined(__linux__)
+  if (ring_) {
+    // Closing the ring cancels the outstanding wakeup read before the eventfd
+    // (and wake_value_) go away
+    ring_ = nullptr;
+    ::close(wake_fd_);
+  }
+#endif
+  fallback_pool_ = nullptr;
+}
+
+void FileLoader::add_outstanding(size_t count) {
+  std::lock_guard l(m_pending_);
+  outstanding_ += count;
+}
+
+void FileLoader::remove_outstanding() {
+  // Notified under the lock - the destructor may return (and destroy the
+  // condition variable) as soon as it sees zero
+  std::lock_guard l(m_pending_);
+  if (--outstanding_ == 0) {
+    cv_outstanding_.notify_all();
+  }
+}
+
+bool FileLoader::is_using_io_uring() const {
+#if defined(__linux__)
+  return ring_ != nullptr;
+#else
+  return false;
+#endif
+}
+
+std::shared_ptr<Promise<FilePromise::result_t>> FileLoader::read(
+    std::string file_name,
+    std::shared_ptr<ExecutionContext> completion_context) {
+  auto request = std::make_unique<Request>();
+  request->FileName = std::move(file_name);
+  request->Result = Promise<FilePromise::result_t>::Create();
+  request->CompletionContext = std::move(completion_context);
+  auto rsl = request->Result;
+
+  submit(std::move(request));
+  return rsl;
+}
+
+std::shared_ptr<Promise<MappedFile::result_t>> FileLoader::map(
+    std::string file_name, MappedFile::AccessHint hint,
+    std::shared_ptr<ExecutionContext> completion_context) {
+  auto request = std::make_unique<Request>();
+  request->FileName = std::move(file_name);
+  request->MappedResult = Promise<MappedFile::result_t>::Create();
+  request->Hint = hint;
+  request->CompletionContext = std::move(completion_context);
+  auto rsl = request->MappedResult;
+
+  submit(std::move(request));
+  return rsl;
+}
+
+std::shared_ptr<Promise<FileLoader::StreamResult>> FileLoader::stream(
+    std::string file_name, ChunkConsumer on_chunk,
+    std::shared_ptr<ExecutionContext> chunk_context, StreamDesc desc) {
+  desc.ChunkSize = std::max<size_t>(desc.ChunkSize, 1);
+  desc.MaxChunksInFlight = std::max(desc.MaxChunksInFlight, 1u);
+
+  auto stream = std::make_shared<Stream>();
+  stream->Loader = this;
+  stream->OnChunk = std::move(on_chunk);
+  stream->ChunkContext = std::move(chunk_context);
+  stream->Params = desc;
+  stream->Result = Promise<StreamResult>::Create();
+  for (uint32_t i = 0; i < desc.MaxChunksInFlight; i++) {
+    // Not value-initialized - every byte handed out is read from the file
+    stream->Buffers.emplace_back(new std::byte[desc.ChunkSize]);
+    stream->FreeBuffers.push_back(i);
+  }
+
+  auto request = std::make_unique<Request>();
+  request->FileName = std::move(file_name);
+  request->StreamState = stream;
+  auto rsl = stream->Result;
+
+  submit(std::move(request));
+  return rsl;
+}
+
+double FileLoader::LoadStats::megabytes_per_second() const {
+  double seconds = std::chrono::duration<double>(Elapsed).count();
+  return seconds > 0. ? Bytes / (1024. * 1024.) / seconds : 0.;
+}
+
+double FileLoader::LoadStats::files_per_second() const {
+  double seconds = std::chrono::duration<double>(Elapsed).count();
+  return seconds > 0. ? FileCount / seconds : 0.;
+}
+
+FileLoader::LoadManyResult FileLoader::load_many(
+    std::vector<std::string> paths, FileLoader::LoadManyOptions options) {
+  auto batch = std::make_shared<Batch>();
+  batch->Loader = this;
+  batch->MaxConcurrent = std::max(options.MaxConcurrent, 1u);
+  batch->CompletionContext = options.CompletionContext;
+  batch->Done = Promise<LoadStats>::Create();
+  batch->StartedAt = std::chrono::steady_clock::now();
+  batch->Stats.FileCount = paths.size();
+
+  LoadManyResult rsl;
+  rsl.Done = batch->Done;
+  rsl.Files.reserve(paths.size());
+
+  std::vector<std::pair<std::pair<uint64_t, uint64_t>, size_t>> order;
+  order.reserve(paths.size());
+
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto request = std::make_unique<Request>();
+    request->FileName = std::move(paths[i]);
+    request->Result = Promise<FilePromise::result_t>::Create();
+    request->CompletionContext = options.CompletionContext;
+    request->OwnerBatch = batch;
+    request->BufferPool = options.BufferPool;
+    rsl.Files.push_back(request->Result);
+
+    // Files that can't be stat'd sort first - they fail without any I/O
+    std::pair<uint64_t, uint64_t> key{0, 0};
+#if !defined(_WIN32)
+    struct stat st;
+    if (options.SortByInode && ::stat(request->FileName.c_str(), &st) == 0) {
+      key = {static_cast<uint64_t>(st.st_dev),
+             static_cast<uint64_t>(st.st_ino)};
+    }
+#endif
+    order.push_back({key, i});
+    batch->Requests.push_back(std::move(request));
+  }
+
+  if (options.SortByInode) {
+    std::stable_sort(
+        order.begin(), order.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<std::unique_ptr<Request>> sorted;
+    sorted.reserve(order.size());
+    for (const auto& [key, idx] : order) {
+      sorted.push_back(std::move(batch->Requests[idx]));
+    }
+    batch->Requests = std::move(sorted);
+  }
+
+  if (batch->Requests.empty()) {
+    ::resolve_on(batch->CompletionContext.get(), batch->Done, batch->Stats);
+    return rsl;
+  }
+
+  add_outstanding(batch->Requests.size());
+  issue_batch(batch);
+  return rsl;
+}
+
+void FileLoader::issue_batch(const std::shared_ptr<Batch>& batch) {
+  std::vector<std::unique_ptr<Request>> to_issue;
+  {
+    std::lock_guard l(batch->Mutex);
+    while (batch->InFlight < batch->MaxConcurrent &&
+           batch->NextRequest < batch->Requests.size()) {
+      to_issue.push_back(std::move(batch->Requests[batch->NextRequest++]));
+      batch->InFlight++;
+    }
+  }
+
+  for (auto& request : to_issue) {
+    batch->Loader->submit(std::move(request));
+  }
+}
+
+std::optional<FileLoader::LoadStats> FileLoader::on_batch_read_finished(
+    const std::shared_ptr<Batch>& batch, const FilePromise::result_t& rsl) {
+  std::lock_guard l(batch->Mutex);
+  batch->InFlight--;
+  if (std::holds_alternative<std::string>(rsl)) {
+    batch->Stats.Bytes += std::get<std::string>(rsl).size();
+  } else {
+    batch->Stats.FailedCount++;
+  }
+
+  if (batch->InFlight > 0 || batch->NextRequest < batch->Requests.size()) {
+    return std::nullopt;
+  }
+
+  batch->Stats.Elapsed = std::chrono::steady_clock::now() - batch->StartedAt;
+  return batch->Stats;
+}
+
+void FileLoader::submit(std::unique_ptr<Request> request) {
+  // load_many files were counted when the batch was created
+  if (!request->OwnerBatch) {
+    add_outstanding(1);
+  }
+
+#if defined(__linux__)
+  if (ring_) {
+    {
+      std::lock_guard l(m_pending_);
+      if (!is_ring_failed_) {
+        pending_.push_back(std::move(request));
+      }
+    }
+    if (request == nullptr) {
+      uint64_t one = 1;
+      (void)::write(wake_fd_, &one, sizeof(one));
+      return;
+    }
+  }
+#endif
+
+  run_blocking(std::move(request));
+}
+
+void FileLoader::run_blocking(std::unique_ptr<Request> request) {
+  fallback_pool_->schedule(Task::Of(
+      [this, request = std::shared_ptr<Request>(std::move(request))]() {
+        if (request->StreamState) {
+          FileLoader::stream_blocking(*request);
+        } else if (request->MappedResult) {
+          FileLoader::finish_mapped(
+              *request, ::map_file_blocking(request->FileName, request->Hint));
+        } else {
+          FileLoader::finish(*request,
+                             ::read_file_blocking(request->FileName,
+                                                  request->BufferPool.get()));
+        }
+        remove_outstanding();
+      }));
+}
+
+void FileLoader::finish(Request& request, FilePromise::result_t rsl) {
+  close_file(request);
+
+  auto batch = std::move(request.OwnerBatch);
+  std::optional<LoadStats> batch_stats;
+  if (batch) {
+    batch_stats = on_batch_read_finished(batch, rsl);
+  }
+
+  ::resolve_on(request.CompletionContext.get(), request.Result,
+               std::move(rsl));
+
+  if (batch) {
+    issue_batch(batch);
+  }
+
+  // After the file's own promise, so that Done implies every file resolved
+  if (batch_stats) {
+    ::resolve_on(batch->CompletionContext.get(), batch->Done, *batch_stats);
+  }
+}
+
+void FileLoader::finish_mapped(Request& request, MappedFile::result_t rsl) {
+  close_file(request);
+  ::resolve_on(request.CompletionContext.get(), request.MappedResult,
+               std::move(rsl));
+}
+
+void FileLoader::fail(Request& request, FileReadError error) {
+  if (request.StreamState) {
+    end_stream(request, error);
+  } else if (request.MappedResult) {
+    finish_mapped(request, error);
+  } else {
+    finish(request, error);
+  }
+}
+
+void FileLoader::close_file(Request& request) {
+#if !defined(_WIN32)
+  if (request.Fd >= 0) {
+    ::close(request.Fd);
+    request.Fd = -1;
+  }
+#endif
+}
+
+void FileLoader::push_chunk(const std::shared_ptr<Stream>& stream,
+                            uint32_t buffer, size_t size) {
+  {
+    std::lock_guard l(stream->Mutex);
+    if (size == 0) {
+      stream->FreeBuffers.push_back(buffer);
+      return;
+    }
+
+    stream->ReadyChunks.push_back({buffer, size});
+    if (stream->IsConsuming) {
+      return;
+    }
+    stream->IsConsuming = true;
+  }
+
+  if (stream->ChunkContext) {
+    stream->ChunkContext->schedule(
+        Task::Of([stream]() { FileLoader::consume_chunks(stream); }));
+  } else {
+    consume_chunks(stream);
+  }
+}
+
+void FileLoader::consume_chunks(const std::shared_ptr<Stream>& stream) {
+  // One chunk per task, so a fast reader does not monopolize chunk_context
+  while (true) {
+    std::unique_lock lock(stream->Mutex);
+    auto [buffer, size] = stream->ReadyChunks.front();
+    stream->ReadyChunks.pop_front();
+    lock.unlock();
+
+    stream->OnChunk(
+        std::span<const std::byte>(stream->Buffers[buffer].get(), size));
+
+    lock.lock();
+    stream->BytesConsumed += size;
+    stream->FreeBuffers.push_back(buffer);
+    stream->BufferFreed.notify_one();
+
+#if defined(__linux__)
+    if (stream->ParkedReader != nullptr) {
+      Request* reader = stream->ParkedReader;
+      stream->ParkedReader = nullptr;
+      lock.unlock();
+      stream->Loader->resume_stream(reader);
+      lock.lock();
+    }
+#endif
+
+    if (stream->ReadyChunks.empty()) {
+      stream->IsConsuming = false;
+      resolve_stream_if_done(stream, std::move(lock));
+      return;
+    }
+
+    if (stream->ChunkContext) {
+      lock.unlock();
+      stream->ChunkContext->schedule(
+          Task::Of([stream]() { FileLoader::consume_chunks(stream); }));
+      return;
+    }
+  }
+}
+
+void FileLoader::end_stream(Request& request,
+                            std::optional<FileReadError> error) {
+  close_file(request);
+
+  auto stream = request.StreamState;
+  std::unique_lock lock(stream->Mutex);
+  stream->IsReaderDone = true;
+  stream->Error = error;
+  resolve_stream_if_done(stream, std::move(lock));
+}
+
+void FileLoader::resolve_stream_if_done(const std::shared_ptr<Stream>& stream,
+                                        std::unique_lock<std::mutex> lock) {
+  if (!stream->IsReaderDone || stream->IsConsuming ||
+      !stream->ReadyChunks.empty() || stream->IsResolved) {
+    return;
+  }
+
+  stream->IsResolved = true;
+  StreamResult rsl = stream->Error ? StreamResult(*stream->Error)
+                                   : StreamResult(stream->BytesConsumed);
+  lock.unlock();
+
+  stream->Result->resolve(std::move(rsl));
+}
+
+void FileLoader::stream_blocking(Request& request) {
+  auto stream = request.StreamState;
+
+  std::ifstream fin(request.FileName, std::ios::binary);
+  if (!fin) {
+    end_stream(request, FileReadError::FileNotFound);
+    return;
+  }
+
+  while (true) {
+    uint32_t buffer;
+    {
+      std::unique_lock l(stream->Mutex);
+      stream->BufferFreed.wait(l, [&]() { return !stream->FreeBuffers.empty(); });
+      buffer = stream->FreeBuffers.front();
+      stream->FreeBuffers.pop_front();
+    }
+
+    fin.read(reinterpret_cast<char*>(stream->Buffers[buffer].get()),
+             stream->Params.ChunkSize);
+    if (fin.bad()) {
+      push_chunk(stream, buffer, 0);
+      end_stream(request, FileReadError::FileNotRead);
+      return;
+    }
+
+    push_chunk(stream, buffer, static_cast<size_t>(fin.gcount()));
+    if (!fin) {
+      end_stream(request, std::nullopt);
+      return;
+    }
+  }
+}
+
+#if defined(__linux__)
+void FileLoader::run_ring() {
+  bool is_wake_armed = false;
+  uint32_t failed_submits = 0;
+
+  // Requests owned by the ring - opening, reading, or parked waiting for a
+  // stream buffer to free up
+  std::unordered_set<Request*> in_flight;
+
+  while (true) {
+    if (!is_wake_armed) {
+      prep_wake();
+      is_wake_armed = true;
+    }
+
+    {
+      std::lock_guard l(m_pending_);
+      if (is_stopping_ && pending_.empty() && in_flight.empty()) {
+        return;
+      }
+
+      while (in_flight.size() < desc_.MaxInFlight && !pending_.empty()) {
+        Request* request = pending_.front().release();
+        pending_.pop_front();
+        in_flight.insert(request);
+        prep_open(request);
+      }
+
+      // Streams that were waiting for their consumer to free a buffer
+      for (Request* request : resumed_streams_) {
+        read_next_chunk(request);
+      }
+      resumed_streams_.clear();
+    }
+
+    int submitted = ring_->submit_and_wait(1);
+    if (submitted < 0) {
+      failed_submits++;
+      if (failed_submits > ::kMaxFailedSubmits ||
+          !::is_transient_submit_error(submitted)) {
+        fail_ring(in_flight);
+        return;
+      }
+    } else {
+      failed_submits = 0;
+    }
+
+    // Draining completions also clears EBUSY (completion queue overflow)
+    io_uring_cqe cqe;
+    while (ring_->pop_cqe(cqe)) {
+      if (cqe.user_data == ::kWakeUserData) {
+        is_wake_armed = false;
+        continue;
+      }
+
+      Request* request = reinterpret_cast<Request*>(cqe.user_data);
+      if (!advance(request, cqe.res)) {
+        in_flight.erase(request);
+        remove_outstanding();
+      }
+    }
+
+    if (failed_submits > 0) {
+      // Out of kernel resources - give them a moment to free up
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(1u << (failed_submits - 1)));
+    }
+  }
+}
+
+void FileLoader::fail_ring(std::unordered_set<Request*>& in_flight) {
+  std::deque<std::unique_ptr<Request>> pending;
+  {
+    std::lock_guard l(m_pending_);
+    fallback_pool_ = create_fallback_pool();
+    is_ring_failed_ = true;
+    pending.swap(pending_);
+  }
+
+  // Never seen by the kernel, so they can still be read the blocking way
+  for (auto& request : pending) {
+    run_blocking(std::move(request));
+  }
+
+  // Entries the kernel never consumed will not complete either
+  for (uint64_t user_data : ring_->take_unsubmitted()) {
+    if (user_data != ::kWakeUserData) {
+      fail_ring_request(in_flight, reinterpret_cast<Request*>(user_data));
+    }
+  }
+
+  // Parked streams wait on their consumer, not the kernel
+  std::vector<Request*> parked;
+  for (Request* request : in_flight) {
+    if (!request->StreamState) continue;
+
+    std::lock_guard l(request->StreamState->Mutex);
+    if (request->StreamState->ParkedReader == request) {
+      request->StreamState->ParkedReader = nullptr;
+      parked.push_back(request);
+    }
+  }
+  for (Request* request : parked) {
+    fail_ring_request(in_flight, request);
+  }
+
+  // Everything left has an operation in the kernel, which may still write to
+  // the request's buffers - fail each request once its completion shows up
+  auto deadline = std::chrono::steady_clock::now() + ::kFailedRingDrainTime;
+  while (!in_flight.empty() && std::chrono::steady_clock::now() < deadline) {
+    std::vector<Request*> resumed;
+    {
+      std::lock_guard l(m_pending_);
+      resumed.swap(resumed_streams_);
+    }
+    for (Request* request : resumed) {
+      fail_ring_request(in_flight, request);
+    }
+
+    io_uring_cqe cqe;
+    while (ring_->pop_cqe(cqe)) {
+      if (cqe.user_data == ::kWakeUserData) continue;
+
+      Request* request = reinterpret_cast<Request*>(cqe.user_data);
+      if (request->CurrentStep == Request::Step::Open && cqe.res >= 0) {
+        request->Fd = cqe.res;
+      }
+      fail_ring_request(in_flight, request);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Still owned by the kernel - resolve their promises, but leak the requests
+  // rather than free memory that may yet be written to
+  for (Request* request : in_flight) {
+    fail(*request, FileReadError::FileNotRead);
+    remove_outstanding();
+  }
+  in_flight.clear();
+}
+
+void FileLoader::fail_ring_request(std::unordered_set<Request*>& in_flight,
+                                   Request* request) {
+  if (in_flight.erase(request) == 0) {
+    return;
+  }
+
+  std::unique_ptr<Request> owned(request);
+  fail(*owned, FileReadError::FileNotRead);
+  remove_outstanding();
+}
+
+io_uring_sqe* FileLoader::claim_sqe() {
+  // The ring has an entry for every in-flight request plus the wakeup read,
+  // and each of them has at most one operation queued at a time
+  io_uring_sqe* sqe = ring_->get_sqe();
+  if (sqe == nullptr) {
+    std::fprintf(stderr, "FileLoader: io_uring submission queue is full\n");
+    std::abort();
+  }
+  return sqe;
+}
+
+void FileLoader::prep_wake() {
+  io_uring_sqe* sqe = claim_sqe();
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = wake_fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(&wake_value_);
+  sqe->len = sizeof(wake_value_);
+  sqe->user_data = ::kWakeUserData;
+}
+
+void FileLoader::prep_open(Request* request) {
+  request->CurrentStep = Request::Step::Open;
+
+  io_uring_sqe* sqe = claim_sqe();
+  sqe->opcode = IORING_OP_OPENAT;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = reinterpret_cast<uint64_t>(request->FileName.c_str());
+  sqe->open_flags = O_RDONLY | O_CLOEXEC;
+  sqe->user_data = reinterpret_cast<uint64_t>(request);
+}
+
+void FileLoader::prep_read(Request* request) {
+  request->CurrentStep = Request::Step::Read;
+
+  io_uring_sqe* sqe = claim_sqe();
+  if (request->StreamState) {
+    const auto& stream = *request->StreamState;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = request->Fd;
+    sqe->addr = reinterpret_cast<uint64_t>(
+        stream.Buffers[request->StreamBuffer].get() + request->ChunkFill);
+    sqe->len = static_cast<uint32_t>(std::min(
+        stream.Params.ChunkSize - request->ChunkFill, ::kMaxReadSize));
+    sqe->off = request->BytesRead;
+    sqe->user_data = reinterpret_cast<uint64_t>(request);
+    return;
+  }
+
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = request->Fd;
+  sqe->addr = reinterpret_cast<uint64_t>(&request->Data[request->BytesRead]);
+  sqe->len = static_cast<uint32_t>(
+      std::min(request->Data.size() - request->BytesRead, ::kMaxReadSize));
+  sqe->off = request->BytesRead;
+  sqe->user_data = reinterpret_cast<uint64_t>(request);
+}
+
+void FileLoader::resume_stream(Request* request) {
+  {
+    std::lock_guard l(m_pending_);
+    resumed_streams_.push_back(request);
+  }
+  uint64_t one = 1;
+  (void)::write(wake_fd_, &one, sizeof(one));
+}
+
+void FileLoader::read_next_chunk(Request* request) {
+  auto& stream = *request->StreamState;
+  {
+    std::lock_guard l(stream.Mutex);
+    if (stream.FreeBuffers.empty()) {
+      stream.ParkedReader = request;
+      return;
+    }
+    request->StreamBuffer = stream.FreeBuffers.front();
+    stream.FreeBuffers.pop_front();
+  }
+
+  request->ChunkFill = 0;
+  prep_read(request);
+}
+
+bool FileLoader::advance(Request* raw_request, int32_t res) {
+  if (res == -EINTR || res == -EAGAIN) {
+    if (raw_request->CurrentStep == Request::Step::Open) {
+      prep_open(raw_request);
+    } else {
+      prep_read(raw_request);
+    }
+    return true;
+  }
+
+  std::unique_ptr<Request> request(raw_request);
+
+  switch (request->CurrentStep) {
+    case Request::Step::Open: {
+      if (res < 0) {
+        fail(*request, res == -ENOENT ? FileReadError::FileNotFound
+                                      : FileReadError::FileNotRead);
+        return false;
+      }
+
+      request->Fd = res;
+
+      // Streams stay in flight while parked waiting for a free buffer
+      if (request->StreamState) {
+        read_next_chunk(request.release());
+        return true;
+      }
+
+      // mmap and madvise only set up the mapping (WillNeed readahead is
+      // asynchronous), so they are cheap enough for the I/O thread
+      if (request->MappedResult) {
+        finish_mapped(*request, MappedFile::Map(request->Fd, request->Hint));
+        return false;
+      }
+
+      // fstat on an open descriptor never waits on the disk
+      struct stat st;
+      if (::fstat(request->Fd, &st) != 0) {
+        fail(*request, FileReadError::FileNotRead);
+        return false;
+      }
+
+      if (request->BufferPool) {
+        request->Data = request->BufferPool->acquire(st.st_size);
+      } else {
+        request->Data.resize(st.st_size);
+      }
+      if (request->Data.empty()) {
+        std::string data = std::move(request->Data);
+        finish(*request, std::move(data));
+        return false;
+      }
+
+      prep_read(request.release());
+      return true;
+    }
+
+    case Request::Step::Read: {
+      if (res < 0) {
+        fail(*request, FileReadError::FileNotRead);
+        return false;
+      }
+
+      if (request->StreamState) {
+        request->BytesRead += res;
+        request->ChunkFill += res;
+        if (res > 0 &&
+            request->ChunkFill < request->StreamState->Params.ChunkSize) {
+          prep_read(request.release());
+          return true;
+        }
+
+        push_chunk(request->StreamState, request->StreamBuffer,
+                   request->ChunkFill);
+        if (res == 0) {
+          end_stream(*request, std::nullopt);
+          return false;
+        }
+
+        read_next_chunk(request.release());
+        return true;
+      }
+
+      request->BytesRead += res;
+
+      // Zero bytes means the file was truncated after it was opened
+      if (res == 0 || request->BytesRead == request->Data.size()) {
+        request->Data.resize(request->BytesRead);
+        std::string data = std::move(request->Data);
+        finish(*request, std::move(data));
+        return false;
+      }
+
+      prep_read(request.release());
+      return true;
+    }
+  }
+
+  return false;
+}
+#endif
+
+}  // namespace igasync::sample
@@ -0,0 +1,359 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_FILE_LOADER_H
+#define IGASYNC_SAMPLES_READ_FILE_FILE_LOADER_H
+
+#include <igasync/blocking_pool.h>
+#include <igasync/execution_context.h>
+#include <igasync/promise.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <unordered_set>
+
+#include "file_promise.h"
+#include "io_uring.h"
+#include "mapped_file.h"
+#include "read_buffer_pool.h"
+
+namespace igasync::sample {
+
+/**
+ * @brief Reads whole files asynchronously for native builds
+ *
+ * On Linux, reads are driven by io_uring from a single I/O thread: every
+ * read queued since the last wakeup is submitted in one batch, and the
+ * open/read steps of all in-flight files complete without blocking any
+ * thread. Where io_uring is unavailable (older kernels, seccomp sandboxes,
+ * other platforms), reads fall back to blocking reads on a BlockingPool.
+ *
+ * At most Desc::MaxInFlight files are open at once in either mode - further
+ * reads wait in a queue, so loading thousands of files neither spawns
+ * thousands of threads nor exhausts file descriptors.
+ *
+ * @code{.cc}
+ * auto loader = FileLoader::Create();
+ * loader->read("mesh.bin", main_thread_tasks)->consume(upload_mesh,
+ *                                                      main_thread_tasks);
+ * @endcode
+ */
+class FileLoader {
+ public:
+  /**
+   * @brief Describes all parameters used to construct a FileLoader, with
+   *        reasonable defaults.
+   */
+  struct Desc {
+    Desc() noexcept {}
+
+    /** Maximum number of files being read at any one time */
+    uint32_t MaxInFlight{64};
+
+    /** Use io_uring if the kernel supports it (Linux only) */
+    bool UseIoUring{true};
+
+    /** Thread count of the blocking fallback (capped by MaxInFlight) */
+    uint32_t FallbackThreadCount{4};
+  };
+
+  /**
+   * @brief Parameters of a single FileLoader::stream call
+   */
+  struct StreamDesc {
+    StreamDesc() noexcept {}
+
+    /** Size of every chunk except (possibly) the last one */
+    size_t ChunkSize{1024 * 1024};
+
+    /**
+     * Chunks read ahead of the consumer. Reading pauses while this many
+     * chunks are waiting to be consumed, so peak memory use of a stream is
+     * ChunkSize * MaxChunksInFlight regardless of file size.
+     */
+    uint32_t MaxChunksInFlight{4};
+  };
+
+  /** Total bytes streamed, or the reason the stream stopped early */
+  using StreamResult = std::variant<uint64_t, FileReadError>;
+  using ChunkConsumer = std::function<void(std::span<const std::byte> chunk)>;
+
+  /**
+   * @brief Parameters of a single FileLoader::load_many call
+   */
+  struct LoadManyOptions {
+    LoadManyOptions() noexcept {}
+
+    /**
+     * Files of this batch being read at once. Files of every batch and
+     * single read also share Desc::MaxInFlight.
+     */
+    uint32_t MaxConcurrent{32};
+
+    /**
+     * Issue reads in (device, inode) order instead of the order given - on
+     * most file systems that is close to on-disk order. Sorting stats every
+     * path on the calling thread.
+     */
+    bool SortByInode{true};
+
+    /** If set, file contents are read into buffers taken from this pool */
+    std::shared_ptr<ReadBufferPool> BufferPool{};
+
+    /** Where the per-file and aggregate promises are resolved */
+    std::shared_ptr<ExecutionContext> CompletionContext{};
+  };
+
+  /**
+   * @brief Throughput of a finished load_many batch
+   */
+  struct LoadStats {
+    size_t FileCount{0};
+    size_t FailedCount{0};
+    uint64_t Bytes{0};
+
+    /** From the load_many call until the last file finished */
+    std::chrono::nanoseconds Elapsed{0};
+
+    double megabytes_per_second() const;
+    double files_per_second() const;
+  };
+
+  struct LoadManyResult {
+    /** Per-file results, in the order the paths were given */
+    std::vector<std::shared_ptr<Promise<FilePromise::result_t>>> Files;
+
+    /** Resolves once every file has been read (or failed) */
+    std::shared_ptr<Promise<LoadStats>> Done;
+  };
+
+ public:
+  static std::shared_ptr<FileLoader> Create(Desc desc = Desc());
+
+  /**
+   * @brief Finishes all queued reads before returning
+   */
+  ~FileLoader();
+
+  FileLoader(const FileLoader&) = delete;
+  FileLoader(FileLoader&&) = delete;
+  FileLoader& operator=(const FileLoader&) = delete;
+  FileLoader& operator=(FileLoader&&) = delete;
+
+  /**
+   * @brief Read the entire contents of a file
+   * @param completion_context Where the returned promise is resolved. If null,
+   *        it is resolved on whichever I/O thread finished the read.
+   */
+  std::shared_ptr<Promise<FilePromise::result_t>> read(
+      std::string file_name,
+      std::shared_ptr<ExecutionContext> completion_context = nullptr);
+
+  /**
+   * @brief Memory map an entire file, read-only. Only opening the file counts
+   *        against Desc::MaxInFlight - pages are read in as they are used.
+   * @param hint Expected access pattern, passed on to madvise
+   * @param completion_context Where the returned promise is resolved. If null,
+   *        it is resolved on whichever I/O thread opened the file.
+   */
+  std::shared_ptr<Promise<MappedFile::result_t>> map(
+      std::string file_name,
+      MappedFile::AccessHint hint = MappedFile::AccessHint::Normal,
+      std::shared_ptr<ExecutionContext> completion_context = nullptr);
+
+  /**
+   * @brief Read a file in fixed-size chunks, handing each chunk to on_chunk
+   *        as soon as it is read, while later chunks are still being read.
+   *
+   * Chunks are passed to on_chunk in file order, one at a time, even if
+   * chunk_context runs tasks on several threads. The chunk memory is reused
+   * once on_chunk returns.
+   *
+   * The file counts against Desc::MaxInFlight until it has been read in full,
+   * so a stream whose chunk_context is never executed holds up other reads,
+   * and the FileLoader destructor.
+   *
+   * @param chunk_context Where on_chunk is invoked. If null, it is invoked on
+   *        the I/O thread, which stalls other reads while it runs.
+   * @return Promise that resolves once the last chunk has been consumed
+   */
+  std::shared_ptr<Promise<StreamResult>> stream(
+      std::string file_name, ChunkConsumer on_chunk,
+      std::shared_ptr<ExecutionContext> chunk_context,
+      StreamDesc desc = StreamDesc());
+
+  /**
+   * @brief Read many whole files with a bounded number in flight at once
+   */
+  LoadManyResult load_many(std::vector<std::string> paths,
+                           LoadManyOptions options = LoadManyOptions());
+
+  /**
+   * @return True if reads go through io_uring rather than the blocking pool
+   */
+  bool is_using_io_uring() const;
+
+ private:
+  FileLoader(Desc desc);
+
+  struct Request;
+
+  /**
+   * @brief Files of one load_many call that have not been issued yet
+   */
+  struct Batch {
+    FileLoader* Loader;
+    uint32_t MaxConcurrent;
+    std::shared_ptr<ExecutionContext> CompletionContext;
+    std::shared_ptr<Promise<LoadStats>> Done;
+    std::chrono::steady_clock::time_point StartedAt;
+
+    std::mutex Mutex;
+    std::vector<std::unique_ptr<Request>> Requests;
+    size_t NextRequest{0};
+    uint32_t InFlight{0};
+    LoadStats Stats;
+  };
+
+  /**
+   * @brief State shared by the reader and the consumer of one stream
+   */
+  struct Stream {
+    FileLoader* Loader;
+    ChunkConsumer OnChunk;
+    std::shared_ptr<ExecutionContext> ChunkContext;
+    StreamDesc Params;
+    std::shared_ptr<Promise<StreamResult>> Result;
+    std::vector<std::unique_ptr<std::byte[]>> Buffers;
+
+    std::mutex Mutex;
+    std::condition_variable BufferFreed;
+    std::deque<uint32_t> FreeBuffers;
+    std::deque<std::pair<uint32_t, size_t>> ReadyChunks;
+    bool IsConsuming{false};
+    bool IsReaderDone{false};
+    bool IsResolved{false};
+    std::optional<FileReadError> Error;
+    uint64_t BytesConsumed{0};
+
+    /** Request waiting on the io_uring path for a buffer to free up */
+    Request* ParkedReader{nullptr};
+  };
+
+  struct Request {
+    enum class Step { Open, Read };
+
+    std::string FileName;
+    std::shared_ptr<ExecutionContext> CompletionContext;
+
+    /** Exactly one of Result (read), MappedResult (map) or Stream is set */
+    std::shared_ptr<Promise<FilePromise::result_t>> Result;
+    std::shared_ptr<Promise<MappedFile::result_t>> MappedResult;
+    MappedFile::AccessHint Hint{MappedFile::AccessHint::Normal};
+    std::shared_ptr<Stream> StreamState;
+
+    /** Set for reads issued by load_many */
+    std::shared_ptr<Batch> OwnerBatch;
+    std::shared_ptr<ReadBufferPool> BufferPool;
+    uint32_t StreamBuffer{0};
+    size_t ChunkFill{0};
+
+    Step CurrentStep{Step::Open};
+    int Fd{-1};
+    std::string Data;
+    size_t BytesRead{0};
+  };
+
+  void submit(std::unique_ptr<Request> request);
+  void run_blocking(std::unique_ptr<Request> request);
+  std::shared_ptr<BlockingPool> create_fallback_pool() const;
+
+  /** Track requests the destructor waits on */
+  void add_outstanding(size_t count);
+  void remove_outstanding();
+
+  /** Issue queued batch requests until the batch is at its limit */
+  static void issue_batch(const std::shared_ptr<Batch>& batch);
+  /** Returns the batch totals if this was its last file */
+  static std::optional<LoadStats> on_batch_read_finished(
+      const std::shared_ptr<Batch>& batch, const FilePromise::result_t& rsl);
+
+  /** Close the request's file and resolve its promise */
+  static void finish(Request& request, FilePromise::result_t rsl);
+  static void finish_mapped(Request& request, MappedFile::result_t rsl);
+  static void fail(Request& request, FileReadError error);
+  static void close_file(Request& request);
+
+  /** Hand a filled buffer to the consumer (or back, if empty) */
+  static void push_chunk(const std::shared_ptr<Stream>& stream,
+                         uint32_t buffer, size_t size);
+  static void end_stream(Request& request,
+                         std::optional<FileReadError> error);
+  static void consume_chunks(const std::shared_ptr<Stream>& stream);
+  static void resolve_stream_if_done(const std::shared_ptr<Stream>& stream,
+                                     std::unique_lock<std::mutex> lock);
+  static void stream_blocking(Request& request);
+
+#if defined(__linux__)
+  void run_ring();
+
+  /**
+   * Stop using the ring after submits keep failing. Queued requests move to
+   * the blocking fallback, and requests the ring holds are failed once the
+   * kernel is done with them.
+   */
+  void fail_ring(std::unordered_set<Request*>& in_flight);
+
+  /** Fail a request held by the ring, and stop tracking it */
+  void fail_ring_request(std::unordered_set<Request*>& in_flight,
+                         Request* request);
+
+  /** Aborts if the submission queue is full, which the ring size rules out */
+  io_uring_sqe* claim_sqe();
+  void prep_wake();
+  void prep_open(Request* request);
+  void prep_read(Request* request);
+  void resume_stream(Request* request);
+
+  /** Claims a free buffer and reads into it, or parks the request */
+  void read_next_chunk(Request* request);
+
+  /** Returns false once the request has finished */
+  bool advance(Request* request, int32_t res);
+#endif
+
+ private:
+  Desc desc_;
+
+#if defined(__linux__)
+  std::unique_ptr<IoUring> ring_;
+  int wake_fd_;
+  uint64_t wake_value_;
+  std::thread ring_thread_;
+
+  /** Guarded by m_pending_. New requests go to fallback_pool_ once set. */
+  bool is_ring_failed_;
+#endif
+
+  std::mutex m_pending_;
+  std::deque<std::unique_ptr<Request>> pending_;
+  std::vector<Request*> resumed_streams_;
+  bool is_stopping_;
+
+  std::shared_ptr<BlockingPool> fallback_pool_;
+
+  /**
+   * Guarded by m_pending_. Requests not yet finished, counting load_many
+   * files that have not been issued yet.
+   */
+  size_t outstanding_;
+  std::condition_variable cv_outstanding_;
+};
+
+}  // namespace igasync::sample
+
+#endif
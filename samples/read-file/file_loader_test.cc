@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "file_loader.h"
+
+using namespace igasync;
+using namespace igasync::sample;
+
+namespace {
+// Directory of small numbered files, removed at the end of the test
+class TempFiles {
+ public:
+  TempFiles(const std::string& name, int count) {
+    dir_ = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    for (int i = 0; i < count; i++) {
+      auto path = (dir_ / (std::to_string(i) + ".txt")).string();
+      std::ofstream(path) << "file " << i;
+      paths_.push_back(path);
+    }
+  }
+
+  ~TempFiles() { std::filesystem::remove_all(dir_); }
+
+  const std::vector<std::string>& paths() const { return paths_; }
+
+ private:
+  std::filesystem::path dir_;
+  std::vector<std::string> paths_;
+};
+
+FileLoader::Desc fallback_desc() {
+  FileLoader::Desc desc;
+  desc.UseIoUring = false;
+  return desc;
+}
+}  // namespace
+
+TEST(FileLoader, fallbackReadsWholeFile) {
+  ::TempFiles files("igasync_file_loader_read", 1);
+  auto loader = FileLoader::Create(::fallback_desc());
+  EXPECT_FALSE(loader->is_using_io_uring());
+
+  auto rsl = loader->read(files.paths()[0]);
+  loader = nullptr;
+
+  ASSERT_TRUE(rsl->is_finished());
+  const auto& data = rsl->unsafe_sync_peek();
+  ASSERT_TRUE(std::holds_alternative<std::string>(data));
+  EXPECT_EQ(std::get<std::string>(data), "file 0");
+}
+
+TEST(FileLoader, fallbackDestructorFinishesUnissuedBatchFiles) {
+  const int kFileCount = 300;
+  ::TempFiles files("igasync_file_loader_batch", kFileCount);
+  auto loader = FileLoader::Create(::fallback_desc());
+
+  FileLoader::LoadManyOptions options;
+  options.MaxConcurrent = 2;
+  auto rsl = loader->load_many(files.paths(), options);
+
+  // Most of the batch has not been handed to the pool yet
+  loader = nullptr;
+
+  for (int i = 0; i < kFileCount; i++) {
+    ASSERT_TRUE(rsl.Files[i]->is_finished());
+    const auto& data = rsl.Files[i]->unsafe_sync_peek();
+    ASSERT_TRUE(std::holds_alternative<std::string>(data));
+    EXPECT_EQ(std::get<std::string>(data), "file " + std::to_string(i));
+  }
+  ASSERT_TRUE(rsl.Done->is_finished());
+  EXPECT_EQ(rsl.Done->unsafe_sync_peek().FileCount, kFileCount);
+  EXPECT_EQ(rsl.Done->unsafe_sync_peek().FailedCount, 0);
+}
+
+TEST(FileLoader, destructorFinishesUnissuedBatchFiles) {
+  const int kFileCount = 300;
+  ::TempFiles files("igasync_file_loader_ring_batch", kFileCount);
+  auto loader = FileLoader::Create();
+
+  FileLoader::LoadManyOptions options;
+  options.MaxConcurrent = 2;
+  auto rsl = loader->load_many(files.paths(), options);
+  loader = nullptr;
+
+  ASSERT_TRUE(rsl.Done->is_finished());
+  EXPECT_EQ(rsl.Done->unsafe_sync_peek().FileCount, kFileCount);
+  EXPECT_EQ(rsl.Done->unsafe_sync_peek().FailedCount, 0);
+}
+
+#if defined(__linux__)
+TEST(IoUring, takeUnsubmittedReturnsClaimedEntries) {
+  auto ring = IoUring::Create(2);
+  if (!ring) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+
+  for (uint64_t user_data : {11u, 22u}) {
+    io_uring_sqe* sqe = ring->get_sqe();
+    ASSERT_NE(sqe, nullptr);
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = user_data;
+  }
+  EXPECT_EQ(ring->get_sqe(), nullptr);
+
+  EXPECT_EQ(ring->take_unsubmitted(), (std::vector<uint64_t>{11, 22}));
+  EXPECT_TRUE(ring->take_unsubmitted().empty());
+
+  // Freed entries can be claimed again, and nothing was sent to the kernel
+  io_uring_sqe* sqe = ring->get_sqe();
+  ASSERT_NE(sqe, nullptr);
+  sqe->opcode = IORING_OP_NOP;
+  sqe->user_data = 33;
+  EXPECT_EQ(ring->submit_and_wait(1), 1);
+
+  io_uring_cqe cqe;
+  ASSERT_TRUE(ring->pop_cqe(cqe));
+  EXPECT_EQ(cqe.user_data, 33u);
+  EXPECT_FALSE(ring->pop_cqe(cqe));
+}
+#endif
@@ -0,0 +1,260 @@
+// Directory hashing sample / I/O throughput check
+//
+// Reads every regular file under a directory through FileLoader::load_many
+// and prints a SHA-256 per file (sha256sum format, sorted by path). Loaded
+// files are collected into groups, and each group is hashed by one
+// multi-buffer sha256_batch call on a thread pool while later files are still
+// being read. Read buffers are handed back to a ReadBufferPool once hashed.
+//
+// Throughput (MB/s, files/s) goes to stderr, or stdout with --json, so runs
+// over the same directory can be compared to catch I/O regressions.
+//
+// Usage: sample-hash-directory [--dir=.] [--max_concurrent=32] [--no_sort]
+//          [--no_io_uring] [--group_size=64]
+//          [--impl=scalar|sse2x4|avx2x8|sha-ni] [--quiet] [--json]
+
+#include <igasync/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "file_loader.h"
+#include "read_buffer_pool.h"
+#include "sha256/sha256_batch.h"
+
+namespace {
+
+struct Config {
+  std::string Dir = ".";
+  int MaxConcurrent = 32;
+  bool SortByInode = true;
+  bool UseIoUring = true;
+  int GroupSize = 64;
+  igasync::sample::Sha256Impl Impl = igasync::sample::sha256_best_impl();
+  bool Quiet = false;
+  bool Json = false;
+};
+
+bool parse_flag(const char* arg, const char* name, std::string& value) {
+  size_t name_len = std::strlen(name);
+  if (std::strncmp(arg, name, name_len) != 0) return false;
+  if (arg[name_len] == '\0') {
+    value = "";
+    return true;
+  }
+  if (arg[name_len] != '=') return false;
+  value = arg + name_len + 1;
+  return true;
+}
+
+Config parse_config(int argc, char** argv) {
+  Config config;
+  for (int i = 1; i < argc; i++) {
+    std::string v;
+    if (parse_flag(argv[i], "--dir", v)) {
+      config.Dir = v;
+    } else if (parse_flag(argv[i], "--max_concurrent", v)) {
+      config.MaxConcurrent = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--no_sort", v)) {
+      config.SortByInode = false;
+    } else if (parse_flag(argv[i], "--no_io_uring", v)) {
+      config.UseIoUring = false;
+    } else if (parse_flag(argv[i], "--group_size", v)) {
+      config.GroupSize = std::atoi(v.c_str());
+    } else if (parse_flag(argv[i], "--impl", v)) {
+      bool is_known = false;
+      for (auto impl : {igasync::sample::Sha256Impl::Scalar,
+                        igasync::sample::Sha256Impl::Sse2x4,
+                        igasync::sample::Sha256Impl::Avx2x8,
+                        igasync::sample::Sha256Impl::ShaNi}) {
+        if (v == igasync::sample::sha256_impl_name(impl)) {
+          config.Impl = impl;
+          is_known = true;
+        }
+      }
+      if (!is_known || !igasync::sample::sha256_impl_supported(config.Impl)) {
+        std::fprintf(stderr, "Unsupported SHA-256 implementation: %s\n",
+                     v.c_str());
+        std::exit(1);
+      }
+    } else if (parse_flag(argv[i], "--quiet", v)) {
+      config.Quiet = true;
+    } else if (parse_flag(argv[i], "--json", v)) {
+      config.Json = true;
+    } else {
+      std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+      std::exit(1);
+    }
+  }
+  return config;
+}
+
+std::vector<std::string> list_files(const std::string& dir) {
+  std::vector<std::string> paths;
+  std::error_code ec;
+  for (auto it = std::filesystem::recursive_directory_iterator(
+           dir, std::filesystem::directory_options::skip_permission_denied,
+           ec);
+       !ec && it != std::filesystem::recursive_directory_iterator();
+       it.increment(ec)) {
+    if (it->is_regular_file(ec)) {
+      paths.push_back(it->path().string());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+// Gathers loaded files into groups and hashes each full group with a single
+// multi-buffer sha256_batch call, on whichever thread completed the group
+class HashStage {
+ public:
+  HashStage(size_t file_count, size_t group_size,
+            igasync::sample::Sha256Impl impl,
+            std::shared_ptr<igasync::sample::ReadBufferPool> buffer_pool)
+      : file_count_(file_count),
+        group_size_(std::max<size_t>(group_size, 1)),
+        impl_(impl),
+        buffer_pool_(std::move(buffer_pool)),
+        hashes_(file_count),
+        received_(0),
+        finished_(0) {}
+
+  void add(size_t file_idx, igasync::sample::FilePromise::result_t rsl) {
+    std::vector<std::pair<size_t, std::string>> group;
+    size_t unreadable = 0;
+    {
+      std::lock_guard l(m_ready_);
+      received_++;
+      if (std::holds_alternative<std::string>(rsl)) {
+        ready_.push_back({file_idx, std::move(std::get<std::string>(rsl))});
+      } else {
+        hashes_[file_idx] = "<unreadable>";
+        unreadable = 1;
+      }
+
+      if (ready_.size() >= group_size_ || received_ == file_count_) {
+        group.swap(ready_);
+      }
+    }
+
+    if (!group.empty()) {
+      std::vector<std::span<const std::byte>> inputs;
+      inputs.reserve(group.size());
+      for (const auto& [idx, data] : group) {
+        inputs.push_back(std::as_bytes(std::span(data)));
+      }
+
+      std::vector<igasync::sample::Sha256Digest> digests(group.size());
+      igasync::sample::sha256_batch(inputs, digests, impl_);
+
+      for (size_t i = 0; i < group.size(); i++) {
+        hashes_[group[i].first] = igasync::sample::sha256_hex(digests[i]);
+        buffer_pool_->release(std::move(group[i].second));
+      }
+    }
+
+    finished_.fetch_add(group.size() + unreadable, std::memory_order_release);
+  }
+
+  bool is_done() const {
+    return finished_.load(std::memory_order_acquire) == file_count_;
+  }
+
+  const std::vector<std::string>& hashes() const { return hashes_; }
+
+ private:
+  const size_t file_count_;
+  const size_t group_size_;
+  const igasync::sample::Sha256Impl impl_;
+  std::shared_ptr<igasync::sample::ReadBufferPool> buffer_pool_;
+
+  // Each entry is written once, by the thread that hashed its group
+  std::vector<std::string> hashes_;
+
+  std::mutex m_ready_;
+  std::vector<std::pair<size_t, std::string>> ready_;
+  size_t received_;
+
+  std::atomic_size_t finished_;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config config = parse_config(argc, argv);
+  auto paths = ::list_files(config.Dir);
+
+  auto thread_pool = igasync::ThreadPool::Create();
+  auto hash_tasks = igasync::TaskList::Create();
+  thread_pool->add_task_list(hash_tasks);
+
+  igasync::sample::FileLoader::Desc loader_desc;
+  loader_desc.UseIoUring = config.UseIoUring;
+  loader_desc.MaxInFlight = std::max(config.MaxConcurrent, 1);
+  auto file_loader = igasync::sample::FileLoader::Create(loader_desc);
+  auto buffer_pool = igasync::sample::ReadBufferPool::Create();
+
+  igasync::sample::FileLoader::LoadManyOptions options;
+  options.MaxConcurrent = loader_desc.MaxInFlight;
+  options.SortByInode = config.SortByInode;
+  options.BufferPool = buffer_pool;
+  auto batch = file_loader->load_many(paths, options);
+
+  auto hash_stage = std::make_shared<::HashStage>(
+      paths.size(), config.GroupSize, config.Impl, buffer_pool);
+  for (size_t i = 0; i < batch.Files.size(); i++) {
+    batch.Files[i]->consume(
+        [hash_stage, i](igasync::sample::FilePromise::result_t rsl) {
+          hash_stage->add(i, std::move(rsl));
+        },
+        hash_tasks);
+  }
+
+  while (!batch.Done->is_finished() || !hash_stage->is_done()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  if (!config.Quiet && !config.Json) {
+    for (size_t i = 0; i < paths.size(); i++) {
+      std::printf("%s  %s\n", hash_stage->hashes()[i].c_str(),
+                  paths[i].c_str());
+    }
+  }
+
+  const auto& stats = batch.Done->unsafe_sync_peek();
+  double elapsed_ms =
+      std::chrono::duration<double, std::milli>(stats.Elapsed).count();
+  if (config.Json) {
+    std::printf(
+        "{\"files\": %zu, \"failed\": %zu, \"bytes\": %llu, "
+        "\"elapsed_ms\": %.3f, \"mb_per_s\": %.3f, \"files_per_s\": %.3f, "
+        "\"io_uring\": %s, \"hash_impl\": \"%s\", \"buffer_reuses\": %llu}\n",
+        stats.FileCount, stats.FailedCount,
+        static_cast<unsigned long long>(stats.Bytes), elapsed_ms,
+        stats.megabytes_per_second(), stats.files_per_second(),
+        file_loader->is_using_io_uring() ? "true" : "false",
+        igasync::sample::sha256_impl_name(config.Impl),
+        static_cast<unsigned long long>(buffer_pool->reuse_count()));
+  } else {
+    std::fprintf(stderr,
+                 "%zu files (%zu failed), %.2f MB in %.1f ms - %.1f MB/s, "
+                 "%.0f files/s (%s, %s)\n",
+                 stats.FileCount, stats.FailedCount,
+                 stats.Bytes / (1024. * 1024.), elapsed_ms,
+                 stats.megabytes_per_second(), stats.files_per_second(),
+                 file_loader->is_using_io_uring() ? "io_uring"
+                                                  : "thread pool",
+                 igasync::sample::sha256_impl_name(config.Impl));
+  }
+
+  thread_pool->remove_task_list(hash_tasks);
+  return 0;
+}
@@ -0,0 +1,207 @@
+#if defined(__linux__)
+
+#include "io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace {
+int io_uring_setup(uint32_t entries, io_uring_params* p) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete,
+                   uint32_t flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(int fd, uint32_t opcode, void* arg, uint32_t nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// Ring indices are shared with the kernel, which reads and writes them
+// concurrently with userspace
+uint32_t load_acquire(uint32_t* p) {
+  return std::atomic_ref<uint32_t>(*p).load(std::memory_order_acquire);
+}
+
+void store_release(uint32_t* p, uint32_t v) {
+  std::atomic_ref<uint32_t>(*p).store(v, std::memory_order_release);
+}
+
+template <typename T>
+T* at_offset(void* base, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+}  // namespace
+
+namespace igasync::sample {
+
+std::unique_ptr<IoUring> IoUring::Create(uint32_t entries) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  int fd = ::io_uring_setup(entries, &params);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  auto ring = std::unique_ptr<IoUring>(new IoUring());
+  ring->fd_ = fd;
+
+  ring->sq_ring_size_ =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool is_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (is_single_mmap) {
+    ring->sq_ring_size_ = ring->cq_ring_size_ =
+        std::max(ring->sq_ring_size_, ring->cq_ring_size_);
+  }
+
+  ring->sq_ring_ =
+      ::mmap(nullptr, ring->sq_ring_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ring_ == MAP_FAILED) {
+    ring->sq_ring_ = nullptr;
+    return nullptr;
+  }
+
+  if (is_single_mmap) {
+    ring->cq_ring_ = ring->sq_ring_;
+  } else {
+    ring->cq_ring_ =
+        ::mmap(nullptr, ring->cq_ring_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (ring->cq_ring_ == MAP_FAILED) {
+      ring->cq_ring_ = nullptr;
+      return nullptr;
+    }
+  }
+
+  ring->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = ::mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return nullptr;
+  }
+  ring->sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  ring->sq_head_ = ::at_offset<uint32_t>(ring->sq_ring_, params.sq_off.head);
+  ring->sq_tail_ = ::at_offset<uint32_t>(ring->sq_ring_, params.sq_off.tail);
+  ring->sq_array_ = ::at_offset<uint32_t>(ring->sq_ring_, params.sq_off.array);
+  ring->sq_mask_ =
+      *::at_offset<uint32_t>(ring->sq_ring_, params.sq_off.ring_mask);
+  ring->sq_entries_ = params.sq_entries;
+  ring->sqe_tail_ = *ring->sq_tail_;
+
+  ring->cq_head_ = ::at_offset<uint32_t>(ring->cq_ring_, params.cq_off.head);
+  ring->cq_tail_ = ::at_offset<uint32_t>(ring->cq_ring_, params.cq_off.tail);
+  ring->cq_mask_ =
+      *::at_offset<uint32_t>(ring->cq_ring_, params.cq_off.ring_mask);
+  ring->cqes_ = ::at_offset<io_uring_cqe>(ring->cq_ring_, params.cq_off.cqes);
+
+  // Probing needs Linux 5.6, which is also the first to support the opcodes
+  // this sample uses - older kernels leave every op marked unsupported
+  std::vector<uint8_t> probe_buf(sizeof(io_uring_probe) +
+                                 256 * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(probe_buf.data());
+  if (::io_uring_register(fd, IORING_REGISTER_PROBE, probe, 256) == 0) {
+    for (uint32_t i = 0; i < probe->ops_len; i++) {
+      if (probe->ops[i].flags & IO_URING_OP_SUPPORTED) {
+        ring->supported_ops_.set(probe->ops[i].op);
+      }
+    }
+  }
+
+  return ring;
+}
+
+IoUring::~IoUring() {
+  if (sqes_) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    ::munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    ::munmap(sq_ring_, sq_ring_size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+bool IoUring::supports(uint8_t opcode) const {
+  return supported_ops_.test(opcode);
+}
+
+io_uring_sqe* IoUring::get_sqe() {
+  if (sqe_tail_ - ::load_acquire(sq_head_) >= sq_entries_) {
+    return nullptr;
+  }
+
+  uint32_t idx = sqe_tail_ & sq_mask_;
+  sq_array_[idx] = idx;
+  sqe_tail_++;
+
+  io_uring_sqe* sqe = &sqes_[idx];
+  std::memset(sqe, 0, sizeof(io_uring_sqe));
+  return sqe;
+}
+
+int IoUring::submit_and_wait(uint32_t wait_nr) {
+  ::store_release(sq_tail_, sqe_tail_);
+  uint32_t to_submit = sqe_tail_ - ::load_acquire(sq_head_);
+
+  uint32_t flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0u;
+  while (true) {
+    int rsl = ::io_uring_enter(fd_, to_submit, wait_nr, flags);
+    if (rsl >= 0) {
+      return rsl;
+    }
+    if (errno != EINTR) {
+      return -errno;
+    }
+    // Entries submitted before the interruption are not resubmitted
+    to_submit = sqe_tail_ - ::load_acquire(sq_head_);
+  }
+}
+
+bool IoUring::pop_cqe(io_uring_cqe& out) {
+  uint32_t head = *cq_head_;
+  if (head == ::load_acquire(cq_tail_)) {
+    return false;
+  }
+
+  out = cqes_[head & cq_mask_];
+  ::store_release(cq_head_, head + 1);
+  return true;
+}
+
+std::vector<uint64_t> IoUring::take_unsubmitted() {
+  // The kernel only consumes entries inside io_uring_enter, which is never
+  // running on another thread
+  uint32_t head = ::load_acquire(sq_head_);
+  std::vector<uint64_t> user_data;
+  for (uint32_t i = head; i != sqe_tail_; i++) {
+    user_data.push_back(sqes_[sq_array_[i & sq_mask_]].user_data);
+  }
+
+  sqe_tail_ = head;
+  ::store_release(sq_tail_, head);
+  return user_data;
+}
+
+}  // namespace igasync::sample
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_IO_URING_H
+#define IGASYNC_SAMPLES_READ_FILE_IO_URING_H
+
+#if defined(__linux__)
+
+#include <linux/io_uring.h>
+
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace igasync::sample {
+
+/**
+ * @brief Minimal io_uring instance driven through raw syscalls (no liburing)
+ *
+ * Not thread safe - one thread prepares submissions and reaps completions.
+ */
+class IoUring {
+ public:
+  /**
+   * @brief Set up a ring with at least the given number of submission entries
+   * @return nullptr if io_uring is unavailable (old kernel, seccomp, etc.)
+   */
+  static std::unique_ptr<IoUring> Create(uint32_t entries);
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring(IoUring&&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+  IoUring& operator=(IoUring&&) = delete;
+
+  /**
+   * @brief True if the running kernel supports the given IORING_OP_*
+   */
+  bool supports(uint8_t opcode) const;
+
+  /**
+   * @brief Claim a zeroed submission entry, or nullptr if the queue is full.
+   *        Claimed entries are sent to the kernel on the next submit call.
+   */
+  io_uring_sqe* get_sqe();
+
+  /**
+   * @brief Submit every claimed entry in a single syscall, and block until at
+   *        least wait_nr completions are available
+   * @return Number of entries submitted, or -errno
+   */
+  int submit_and_wait(uint32_t wait_nr);
+
+  /**
+   * @brief Pop the oldest completion, if there is one
+   */
+  bool pop_cqe(io_uring_cqe& out);
+
+  /**
+   * @brief Take back claimed entries the kernel has not consumed yet (e.g.
+   *        after a failed submit), so that they are never submitted
+   * @return user_data of every entry taken back, oldest first
+   */
+  std::vector<uint64_t> take_unsubmitted();
+
+ private:
+  IoUring() = default;
+
+  int fd_{-1};
+
+  void* sq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  void* cq_ring_{nullptr};
+  size_t cq_ring_size_{0};
+  io_uring_sqe* sqes_{nullptr};
+  size_t sqes_size_{0};
+
+  uint32_t* sq_head_{nullptr};
+  uint32_t* sq_tail_{nullptr};
+  uint32_t* sq_array_{nullptr};
+  uint32_t sq_mask_{0};
+  uint32_t sq_entries_{0};
+  uint32_t sqe_tail_{0};
+
+  uint32_t* cq_head_{nullptr};
+  uint32_t* cq_tail_{nullptr};
+  uint32_t cq_mask_{0};
+  io_uring_cqe* cqes_{nullptr};
+
+  std::bitset<256> supported_ops_;
+};
+
+}  // namespace igasync::sample
+
+#endif
+
+#endif
@@ -3,6 +3,11 @@
 
 #include <iostream>
 
+#if defined(__linux__)
+#include <poll.h>
+#endif
+
+#include "file_loader.h"
 #include "file_promise.h"
 #include "sha256/picosha2.h"
 
@@ -25,22 +30,58 @@ auto read_file_or_default(std::string file_name, std::string default_value,
 std::string hash(const std::string& s) {
   return picosha2::hash256_hex_string(s);
 }
+
+// Hashes the file a chunk at a time while the rest of it is still being read,
+// instead of waiting for the whole file to be in memory
+auto hash_file_or_default(
+    igasync::sample::FileLoader& file_loader, std::string file_name,
+    std::string default_value,
+    std::shared_ptr<igasync::TaskList> async_task_list,
+    std::shared_ptr<igasync::TaskList> main_task_list) {
+  auto hasher = std::make_shared<picosha2::hash256_one_by_one>();
+
+  return file_loader
+      .stream(
+          file_name,
+          [hasher](std::span<const std::byte> chunk) {
+            auto* data = reinterpret_cast<const unsigned char*>(chunk.data());
+            hasher->process(data, data + chunk.size());
+          },
+          async_task_list)
+      ->then(
+          [hasher, default_value = std::move(default_value)](
+              const igasync::sample::FileLoader::StreamResult& rsl) {
+            if (std::holds_alternative<igasync::sample::FileReadError>(rsl)) {
+              return ::hash(default_value);
+            }
+
+            hasher->finish();
+            return picosha2::get_hash_hex_string(*hasher);
+          },
+          main_task_list);
+}
 }  // namespace
 
 int main() {
   auto thread_pool = igasync::ThreadPool::Create();
   auto async_task_list = igasync::TaskList::Create();
-  auto main_thread_list = igasync::TaskList::Create();
+  igasync::TaskList::Desc main_thread_desc;
+  main_thread_desc.UseReadinessFd = true;
+  auto main_thread_list = igasync::TaskList::Create(main_thread_desc);
   thread_pool->add_task_list(async_task_list);
+  auto file_loader = igasync::sample::FileLoader::Create();
 
   auto dataFilePromise =
       ::read_file_or_default("data_file.txt", "EMPTY TEXT", main_thread_list);
-  auto dataFileHashPromise = dataFilePromise->then(::hash, main_thread_list);
+  auto dataFileHashPromise =
+      ::hash_file_or_default(*file_loader, "data_file.txt", "EMPTY TEXT",
+                             async_task_list, main_thread_list);
 
   auto missingFilePromise = ::read_file_or_default(
       "missing_file.txt", "Missing File Text", main_thread_list);
-  auto missingFileHashPromise =
-      missingFilePromise->then(::hash, main_thread_list);
+  auto missingFileHashPromise = ::hash_file_or_default(
+      *file_loader, "missing_file.txt", "Missing File Text", async_task_list,
+      main_thread_list);
 
   auto dataFilePromiseCombiner = igasync::PromiseCombiner::Create();
   auto data_file_key =
@@ -75,7 +116,7 @@ int main() {
       },
       main_thread_list);
 
-  // For ten seconds, sleep for a bit and hope for finishing
+  // For ten seconds, wait for main thread tasks and hope for finishing
   for (int i = 0; i < 200; i++) {
     if (missing_file_done->is_finished() && data_file_done->is_finished()) {
       break;
@@ -83,7 +124,13 @@ int main() {
     while (main_thread_list->execute_next())
       ;
 
+#if defined(__linux__)
+    // Wakes up as soon as a task is scheduled on the main thread list
+    pollfd main_thread_ready{main_thread_list->readiness_fd(), POLLIN, 0};
+    ::poll(&main_thread_ready, 1, 50);
+#else
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
+#endif
   }
 
   std::cout << "FINISHED" << std::endl;
@@ -0,0 +1,77 @@
+#include "mapped_file.h"
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace igasync::sample {
+
+MappedFile::MappedFile(void* data, size_t size) : data_(data), size_(size) {}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+#endif
+}
+
+MappedFile::result_t MappedFile::Map(int fd, MappedFile::AccessHint hint) {
+#if defined(_WIN32)
+  // TODO (sessamekesh): Support CreateFileMapping on Windows
+  return FileReadError::FileNotRead;
+#else
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    return FileReadError::FileNotRead;
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+
+  // Zero-length mappings are not allowed - nothing to map anyways
+  if (size == 0) {
+    return std::shared_ptr<const MappedFile>(new MappedFile(nullptr, 0));
+  }
+
+  void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return FileReadError::FileNotRead;
+  }
+
+  int advice = MADV_NORMAL;
+  switch (hint) {
+    case AccessHint::Normal:
+      advice = MADV_NORMAL;
+      break;
+    case AccessHint::Sequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case AccessHint::Random:
+      advice = MADV_RANDOM;
+      break;
+    case AccessHint::WillNeed:
+      advice = MADV_WILLNEED;
+      break;
+  }
+
+  // Hints only - a failure here does not affect correctness
+  if (advice != MADV_NORMAL) {
+    ::madvise(data, size, advice);
+  }
+
+  return std::shared_ptr<const MappedFile>(new MappedFile(data, size));
+#endif
+}
+
+std::span<const std::byte> MappedFile::bytes() const {
+  return {static_cast<const std::byte*>(data_), size_};
+}
+
+std::string_view MappedFile::view() const {
+  return {static_cast<const char*>(data_), size_};
+}
+
+size_t MappedFile::size() const { return size_; }
+
+}  // namespace igasync::sample
@@ -0,0 +1,73 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_MAPPED_FILE_H
+#define IGASYNC_SAMPLES_READ_FILE_MAPPED_FILE_H
+
+#include <igasync/promise.h>
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <variant>
+
+#include "file_promise.h"
+
+namespace igasync::sample {
+
+/**
+ * @brief Read-only memory mapping of an entire file
+ *
+ * Pages are read in by the OS as they are first touched, so mapping a large
+ * pack file costs no upfront copy. Share the mapping between consumers by
+ * copying the shared_ptr - the file stays mapped until the last copy goes
+ * away.
+ */
+class MappedFile {
+ public:
+  /** madvise hint applied to the whole mapping */
+  enum class AccessHint {
+    Normal,
+    /** Read front to back - aggressive readahead, pages dropped after use */
+    Sequential,
+    /** Scattered reads - no readahead */
+    Random,
+    /** Start reading the whole file in now, in the background */
+    WillNeed,
+  };
+
+  using result_t = std::variant<std::shared_ptr<const MappedFile>, FileReadError>;
+
+  /**
+   * @brief Map an open file. The descriptor is not consumed, and may be
+   *        closed as soon as this returns.
+   */
+  static result_t Map(int fd, AccessHint hint = AccessHint::Normal);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  std::span<const std::byte> bytes() const;
+  std::string_view view() const;
+  size_t size() const;
+
+ private:
+  MappedFile(void* data, size_t size);
+
+  void* data_;
+  size_t size_;
+};
+
+class MappedFilePromise {
+ public:
+  using result_t = MappedFile::result_t;
+
+  static std::shared_ptr<Promise<result_t>> Create(
+      const std::string& file_name,
+      MappedFile::AccessHint hint = MappedFile::AccessHint::Normal);
+};
+
+}  // namespace igasync::sample
+
+#endif
@@ -0,0 +1,54 @@
+#include "read_buffer_pool.h"
+
+namespace igasync::sample {
+
+std::shared_ptr<ReadBufferPool> ReadBufferPool::Create(
+    ReadBufferPool::Desc desc) {
+  return std::shared_ptr<ReadBufferPool>(new ReadBufferPool(desc));
+}
+
+ReadBufferPool::ReadBufferPool(ReadBufferPool::Desc desc)
+    : desc_(desc), reuse_count_(0) {}
+
+std::string ReadBufferPool::acquire(size_t size) {
+  std::string buffer;
+  {
+    std::lock_guard l(m_buffers_);
+    size_t best = buffers_.size();
+    for (size_t i = 0; i < buffers_.size(); i++) {
+      if (buffers_[i].capacity() >= size &&
+          (best == buffers_.size() ||
+           buffers_[i].capacity() < buffers_[best].capacity())) {
+        best = i;
+      }
+    }
+
+    if (best < buffers_.size()) {
+      buffer = std::move(buffers_[best]);
+      buffers_[best] = std::move(buffers_.back());
+      buffers_.pop_back();
+      reuse_count_++;
+    }
+  }
+
+  buffer.resize(size);
+  return buffer;
+}
+
+void ReadBufferPool::release(std::string buffer) {
+  if (buffer.capacity() == 0) {
+    return;
+  }
+
+  std::lock_guard l(m_buffers_);
+  if (buffers_.size() < desc_.MaxPooledBuffers) {
+    buffers_.push_back(std::move(buffer));
+  }
+}
+
+uint64_t ReadBufferPool::reuse_count() const {
+  std::lock_guard l(m_buffers_);
+  return reuse_count_;
+}
+
+}  // namespace igasync::sample
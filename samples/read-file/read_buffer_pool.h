@@ -0,0 +1,59 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_READ_BUFFER_POOL_H
+#define IGASYNC_SAMPLES_READ_FILE_READ_BUFFER_POOL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace igasync::sample {
+
+/**
+ * @brief Recycles the strings that whole-file reads land in
+ *
+ * Consumers that are done with a file's contents hand the string back with
+ * release(), and later reads reuse its allocation instead of allocating
+ * (and page faulting in) a fresh one.
+ */
+class ReadBufferPool {
+ public:
+  /**
+   * @brief Describes all parameters used to construct a ReadBufferPool, with
+   *        reasonable defaults.
+   */
+  struct Desc {
+    Desc() noexcept {}
+
+    /** Released buffers beyond this many are freed instead of kept */
+    size_t MaxPooledBuffers{64};
+  };
+
+ public:
+  static std::shared_ptr<ReadBufferPool> Create(Desc desc = Desc());
+
+  /**
+   * @brief Get a string of exactly size bytes (contents unspecified), reusing
+   *        the smallest pooled buffer that is large enough
+   */
+  std::string acquire(size_t size);
+
+  void release(std::string buffer);
+
+  /** Number of acquire() calls satisfied by a pooled buffer */
+  uint64_t reuse_count() const;
+
+ private:
+  ReadBufferPool(Desc desc);
+
+ private:
+  Desc desc_;
+
+  mutable std::mutex m_buffers_;
+  std::vector<std::string> buffers_;
+  uint64_t reuse_count_;
+};
+
+}  // namespace igasync::sample
+
+#endif
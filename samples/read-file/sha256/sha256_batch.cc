@@ -0,0 +1,171 @@
+#include "sha256_batch.h"
+
+#include "sha256_batch_internal.h"
+#include "sha256_multi_buffer.inl"
+
+#if defined(IGASYNC_SAMPLE_SHA256_X86)
+#include <cpuid.h>
+#endif
+
+namespace {
+struct ScalarLanes {
+  using vec = uint32_t;
+  static constexpr size_t kLanes = 1;
+
+  static vec load(const uint32_t* p) { return *p; }
+  static void store(uint32_t* p, vec v) { *p = v; }
+  static vec set1(uint32_t v) { return v; }
+  static vec add(vec a, vec b) { return a + b; }
+  static vec xor_(vec a, vec b) { return a ^ b; }
+  static vec and_(vec a, vec b) { return a & b; }
+  static vec or_(vec a, vec b) { return a | b; }
+  static vec andnot(vec a, vec b) { return ~a & b; }
+
+  template <int N>
+  static vec shr(vec v) {
+    return v >> N;
+  }
+  template <int N>
+  static vec rotr(vec v) {
+    return (v >> N) | (v << (32 - N));
+  }
+};
+
+#if defined(IGASYNC_SAMPLE_SHA256_X86)
+bool cpu_has_sha_ni() {
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  bool has_ssse3 = (ecx & (1u << 9)) != 0;
+  bool has_sse41 = (ecx & (1u << 19)) != 0;
+
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  bool has_sha = (ebx & (1u << 29)) != 0;
+
+  return has_ssse3 && has_sse41 && has_sha;
+}
+#endif
+}  // namespace
+
+namespace igasync::sample {
+
+namespace detail {
+void sha256_batch_scalar(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs) {
+  sha256_multi_buffer<::ScalarLanes>(inputs, outputs);
+}
+}  // namespace detail
+
+const char* sha256_impl_name(Sha256Impl impl) {
+  switch (impl) {
+    case Sha256Impl::Scalar:
+      return "scalar";
+    case Sha256Impl::Sse2x4:
+      return "sse2x4";
+    case Sha256Impl::Avx2x8:
+      return "avx2x8";
+    case Sha256Impl::ShaNi:
+      return "sha-ni";
+  }
+  return "unknown";
+}
+
+bool sha256_impl_supported(Sha256Impl impl) {
+  switch (impl) {
+    case Sha256Impl::Scalar:
+      return true;
+#if defined(IGASYNC_SAMPLE_SHA256_X86)
+    case Sha256Impl::Sse2x4:
+      return __builtin_cpu_supports("sse2");
+    case Sha256Impl::Avx2x8:
+      return __builtin_cpu_supports("avx2");
+    case Sha256Impl::ShaNi: {
+      static const bool has_sha_ni = ::cpu_has_sha_ni();
+      return has_sha_ni;
+    }
+#endif
+    default:
+      return false;
+  }
+}
+
+Sha256Impl sha256_best_impl() {
+  static const Sha256Impl best = []() {
+    for (auto impl : {Sha256Impl::ShaNi, Sha256Impl::Avx2x8,
+                      Sha256Impl::Sse2x4}) {
+      if (sha256_impl_supported(impl)) {
+        return impl;
+      }
+    }
+    return Sha256Impl::Scalar;
+  }();
+  return best;
+}
+
+void sha256_batch(std::span<const std::span<const std::byte>> inputs,
+                  std::span<Sha256Digest> outputs, Sha256Impl impl) {
+  switch (impl) {
+#if defined(IGASYNC_SAMPLE_SHA256_X86)
+    case Sha256Impl::Sse2x4:
+      detail::sha256_batch_sse2x4(inputs, outputs);
+      return;
+    case Sha256Impl::Avx2x8:
+      detail::sha256_batch_avx2x8(inputs, outputs);
+      return;
+    case Sha256Impl::ShaNi:
+      detail::sha256_batch_shani(inputs, outputs);
+      return;
+#endif
+    default:
+      detail::sha256_batch_scalar(inputs, outputs);
+      return;
+  }
+}
+
+std::shared_ptr<Promise<std::vector<Sha256Digest>>> sha256_batch_async(
+    std::vector<std::span<const std::byte>> inputs,
+    std::shared_ptr<ExecutionContext> execution_context, size_t group_size,
+    ParallelDesc desc) {
+  group_size = std::max<size_t>(group_size, 1);
+  size_t group_count = (inputs.size() + group_size - 1) / group_size;
+
+  auto shared_inputs =
+      std::make_shared<std::vector<std::span<const std::byte>>>(
+          std::move(inputs));
+  auto digests =
+      std::make_shared<std::vector<Sha256Digest>>(shared_inputs->size());
+  Sha256Impl impl = sha256_best_impl();
+
+  // Each index is a whole group, so the partitioner never needs to split one
+  desc.GrainSize = 1;
+
+  return parallel_for(
+             size_t{0}, group_count,
+             [shared_inputs, digests, group_size, impl](size_t group) {
+               size_t begin = group * group_size;
+               size_t count =
+                   std::min(group_size, shared_inputs->size() - begin);
+               sha256_batch(
+                   std::span(*shared_inputs).subspan(begin, count),
+                   std::span(*digests).subspan(begin, count), impl);
+             },
+             execution_context, desc)
+      ->then([digests]() { return std::move(*digests); },
+             execution_context);
+}
+
+std::string sha256_hex(const Sha256Digest& digest) {
+  static const char kHexDigits[] = "0123456789abcdef";
+
+  std::string hex(64, '\0');
+  for (size_t i = 0; i < digest.size(); i++) {
+    hex[2 * i] = kHexDigits[digest[i] >> 4];
+    hex[2 * i + 1] = kHexDigits[digest[i] & 0xf];
+  }
+  return hex;
+}
+
+}  // namespace igasync::sample
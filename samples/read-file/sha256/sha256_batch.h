@@ -0,0 +1,77 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_SHA256_SHA256_BATCH_H
+#define IGASYNC_SAMPLES_READ_FILE_SHA256_SHA256_BATCH_H
+
+#include <igasync/execution_context.h>
+#include <igasync/parallel.h>
+#include <igasync/promise.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace igasync::sample {
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+/**
+ * @brief SHA-256 implementations available to sha256_batch
+ */
+enum class Sha256Impl {
+  /** Portable, one buffer at a time */
+  Scalar,
+  /** SSE2, four buffers at once (one per 32-bit lane) */
+  Sse2x4,
+  /** AVX2, eight buffers at once */
+  Avx2x8,
+  /** SHA extensions (SHA-NI), one buffer at a time in hardware */
+  ShaNi,
+};
+
+const char* sha256_impl_name(Sha256Impl impl);
+
+/**
+ * @brief True if impl was compiled in and the running CPU supports it
+ */
+bool sha256_impl_supported(Sha256Impl impl);
+
+/**
+ * @brief Fastest supported implementation - SHA-NI where the CPU has it,
+ *        otherwise the widest multi-buffer SIMD path. Detected once, at
+ *        first use.
+ */
+Sha256Impl sha256_best_impl();
+
+/**
+ * @brief Hash every input on the calling thread
+ *
+ * Multi-buffer implementations keep every lane busy by refilling a lane with
+ * the next input as soon as its current input is done, so inputs of very
+ * different lengths still hash at close to full width.
+ *
+ * @param outputs Same length as inputs
+ * @param impl Must be supported (see sha256_impl_supported)
+ */
+void sha256_batch(std::span<const std::span<const std::byte>> inputs,
+                  std::span<Sha256Digest> outputs,
+                  Sha256Impl impl = sha256_best_impl());
+
+/**
+ * @brief Hash every input, spreading groups of inputs across the threads
+ *        servicing execution_context. Inputs must stay alive until the
+ *        returned promise resolves.
+ * @param group_size Inputs hashed together by one sha256_batch call
+ * @return Digests, in input order
+ */
+std::shared_ptr<Promise<std::vector<Sha256Digest>>> sha256_batch_async(
+    std::vector<std::span<const std::byte>> inputs,
+    std::shared_ptr<ExecutionContext> execution_context,
+    size_t group_size = 64, ParallelDesc desc = ParallelDesc());
+
+std::string sha256_hex(const Sha256Digest& digest);
+
+}  // namespace igasync::sample
+
+#endif
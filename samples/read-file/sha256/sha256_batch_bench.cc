@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "picosha2.h"
+#include "sha256_batch.h"
+
+using namespace igasync::sample;
+
+namespace {
+std::vector<std::vector<std::byte>> make_buffers(size_t count, size_t size) {
+  std::mt19937 rng(42);
+  std::vector<std::vector<std::byte>> buffers(count);
+  for (auto& buffer : buffers) {
+    buffer.resize(size);
+    for (auto& b : buffer) b = static_cast<std::byte>(rng());
+  }
+  return buffers;
+}
+}  // namespace
+
+// Baseline: what the read-file sample did before - picosha2, one buffer at a
+// time
+static void BM_Picosha2(benchmark::State& state) {
+  auto buffers = ::make_buffers(64, state.range(0));
+  std::vector<unsigned char> digest(picosha2::k_digest_size);
+
+  for (auto _ : state) {
+    for (const auto& buffer : buffers) {
+      auto* p = reinterpret_cast<const unsigned char*>(buffer.data());
+      picosha2::hash256(p, p + buffer.size(), digest.begin(), digest.end());
+      benchmark::DoNotOptimize(digest.data());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buffers.size() *
+                          state.range(0));
+}
+BENCHMARK(BM_Picosha2)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_Sha256Batch(benchmark::State& state, Sha256Impl impl) {
+  if (!sha256_impl_supported(impl)) {
+    state.SkipWithError("Not supported on this CPU");
+    return;
+  }
+
+  auto buffers = ::make_buffers(64, state.range(0));
+  std::vector<std::span<const std::byte>> inputs(buffers.begin(),
+                                                 buffers.end());
+  std::vector<Sha256Digest> digests(inputs.size());
+
+  for (auto _ : state) {
+    sha256_batch(inputs, digests, impl);
+    benchmark::DoNotOptimize(digests.data());
+  }
+  state.SetBytesProcessed(state.iterations() * buffers.size() *
+                          state.range(0));
+}
+BENCHMARK_CAPTURE(BM_Sha256Batch, scalar, Sha256Impl::Scalar)
+    ->Arg(64)
+    ->Arg(4096)
+    ->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Sha256Batch, sse2x4, Sha256Impl::Sse2x4)
+    ->Arg(64)
+    ->Arg(4096)
+    ->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Sha256Batch, avx2x8, Sha256Impl::Avx2x8)
+    ->Arg(64)
+    ->Arg(4096)
+    ->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Sha256Batch, sha_ni, Sha256Impl::ShaNi)
+    ->Arg(64)
+    ->Arg(4096)
+    ->Arg(1 << 20);
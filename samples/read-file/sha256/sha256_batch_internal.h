@@ -0,0 +1,25 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_SHA256_SHA256_BATCH_INTERNAL_H
+#define IGASYNC_SAMPLES_READ_FILE_SHA256_SHA256_BATCH_INTERNAL_H
+
+#include "sha256_batch.h"
+
+// Each implementation lives in its own translation unit, compiled with just
+// the instruction set extensions it needs (see CMakeLists.txt). They are only
+// called after a runtime CPU check.
+namespace igasync::sample::detail {
+
+void sha256_batch_scalar(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs);
+
+#if defined(IGASYNC_SAMPLE_SHA256_X86)
+void sha256_batch_sse2x4(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs);
+void sha256_batch_avx2x8(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs);
+void sha256_batch_shani(std::span<const std::span<const std::byte>> inputs,
+                        std::span<Sha256Digest> outputs);
+#endif
+
+}  // namespace igasync::sample::detail
+
+#endif
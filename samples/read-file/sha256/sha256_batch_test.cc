@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <igasync/task_list.h>
+#include <igasync/thread_pool.h>
+
+#include <random>
+
+#include "picosha2.h"
+#include "sha256_batch.h"
+
+using namespace igasync;
+using namespace igasync::sample;
+
+namespace {
+const Sha256Impl kAllImpls[] = {Sha256Impl::Scalar, Sha256Impl::Sse2x4,
+                                Sha256Impl::Avx2x8, Sha256Impl::ShaNi};
+
+std::string picosha2_hex(const std::vector<std::byte>& data) {
+  auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  return picosha2::hash256_hex_string(p, p + data.size());
+}
+
+// Lengths around every padding boundary, plus a few multi-block inputs
+std::vector<std::vector<std::byte>> make_inputs() {
+  std::vector<size_t> sizes;
+  for (size_t i = 0; i <= 130; i++) sizes.push_back(i);
+  for (size_t s : {1000u, 4095u, 4096u, 65537u, 200000u}) sizes.push_back(s);
+
+  std::mt19937 rng(1234);
+  std::vector<std::vector<std::byte>> inputs;
+  for (size_t size : sizes) {
+    std::vector<std::byte> data(size);
+    for (auto& b : data) b = static_cast<std::byte>(rng());
+    inputs.push_back(std::move(data));
+  }
+  return inputs;
+}
+
+std::vector<std::span<const std::byte>> as_spans(
+    const std::vector<std::vector<std::byte>>& inputs) {
+  std::vector<std::span<const std::byte>> spans;
+  for (const auto& input : inputs) spans.push_back(input);
+  return spans;
+}
+}  // namespace
+
+TEST(Sha256Batch, scalarIsAlwaysSupported) {
+  EXPECT_TRUE(sha256_impl_supported(Sha256Impl::Scalar));
+  EXPECT_TRUE(sha256_impl_supported(sha256_best_impl()));
+}
+
+TEST(Sha256Batch, hashesKnownVector) {
+  const char msg[] = "abc";
+  std::span<const std::byte> input(reinterpret_cast<const std::byte*>(msg), 3);
+
+  for (auto impl : ::kAllImpls) {
+    if (!sha256_impl_supported(impl)) continue;
+
+    Sha256Digest digest;
+    sha256_batch(std::span(&input, 1), std::span(&digest, 1), impl);
+    EXPECT_EQ(
+        sha256_hex(digest),
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")
+        << sha256_impl_name(impl);
+  }
+}
+
+TEST(Sha256Batch, matchesPicosha2ForEveryImplementation) {
+  auto inputs = ::make_inputs();
+  auto spans = ::as_spans(inputs);
+
+  for (auto impl : ::kAllImpls) {
+    if (!sha256_impl_supported(impl)) continue;
+
+    std::vector<Sha256Digest> digests(spans.size());
+    sha256_batch(spans, digests, impl);
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+      EXPECT_EQ(sha256_hex(digests[i]), ::picosha2_hex(inputs[i]))
+          << sha256_impl_name(impl) << ", input size " << inputs[i].size();
+    }
+  }
+}
+
+TEST(Sha256Batch, handlesBatchesSmallerThanLaneCount) {
+  auto inputs = ::make_inputs();
+  inputs.resize(3);
+  auto spans = ::as_spans(inputs);
+
+  for (auto impl : ::kAllImpls) {
+    if (!sha256_impl_supported(impl)) continue;
+
+    std::vector<Sha256Digest> digests(spans.size());
+    sha256_batch(spans, digests, impl);
+    for (size_t i = 0; i < inputs.size(); i++) {
+      EXPECT_EQ(sha256_hex(digests[i]), ::picosha2_hex(inputs[i]))
+          << sha256_impl_name(impl);
+    }
+  }
+}
+
+TEST(Sha256Batch, asyncSpreadsGroupsAcrossThreadPool) {
+  auto inputs = ::make_inputs();
+  auto tl = TaskList::Create();
+  auto pool = ThreadPool::Create();
+  pool->add_task_list(tl);
+
+  auto rsl = sha256_batch_async(::as_spans(inputs), tl, 8);
+  while (!rsl->is_finished()) {
+    tl->execute_next();
+  }
+
+  const auto& digests = rsl->unsafe_sync_peek();
+  ASSERT_EQ(digests.size(), inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    EXPECT_EQ(sha256_hex(digests[i]), ::picosha2_hex(inputs[i]));
+  }
+
+  pool->remove_task_list(tl);
+}
+
+TEST(Sha256Batch, asyncResolvesEmptyBatch) {
+  auto tl = TaskList::Create();
+
+  auto rsl = sha256_batch_async({}, tl);
+  while (tl->execute_next())
+    ;
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_TRUE(rsl->unsafe_sync_peek().empty());
+}
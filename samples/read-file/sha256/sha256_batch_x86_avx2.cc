@@ -0,0 +1,43 @@
+#include <immintrin.h>
+
+#include "sha256_batch_internal.h"
+#include "sha256_multi_buffer.inl"
+
+namespace {
+struct Avx2Lanes {
+  using vec = __m256i;
+  static constexpr size_t kLanes = 8;
+
+  static vec load(const uint32_t* p) {
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static void store(uint32_t* p, vec v) {
+    _mm256_store_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static vec set1(uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+  static vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+  static vec xor_(vec a, vec b) { return _mm256_xor_si256(a, b); }
+  static vec and_(vec a, vec b) { return _mm256_and_si256(a, b); }
+  static vec or_(vec a, vec b) { return _mm256_or_si256(a, b); }
+  static vec andnot(vec a, vec b) { return _mm256_andnot_si256(a, b); }
+
+  template <int N>
+  static vec shr(vec v) {
+    return _mm256_srli_epi32(v, N);
+  }
+  template <int N>
+  static vec rotr(vec v) {
+    return _mm256_or_si256(_mm256_srli_epi32(v, N),
+                           _mm256_slli_epi32(v, 32 - N));
+  }
+};
+}  // namespace
+
+namespace igasync::sample::detail {
+
+void sha256_batch_avx2x8(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs) {
+  sha256_multi_buffer<::Avx2Lanes>(inputs, outputs);
+}
+
+}  // namespace igasync::sample::detail
@@ -0,0 +1,93 @@
+#include <immintrin.h>
+
+#include "sha256_batch_internal.h"
+#include "sha256_multi_buffer.inl"
+
+namespace {
+/**
+ * Compress blocks into state (standard word order a..h) with the SHA
+ * extensions, which keep the state as two vectors - ABEF and CDGH.
+ */
+void compress_blocks(uint32_t (&state)[8], const uint8_t* data,
+                     size_t block_count) {
+  using igasync::sample::detail::kSha256K;
+
+  const __m128i byte_swap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+  __m128i state1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);        // CDAB
+  state1 = _mm_shuffle_epi32(state1, 0x1B);  // EFGH
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);       // CDGH
+
+  for (size_t block = 0; block < block_count; block++, data += 64) {
+    __m128i abef_save = state0;
+    __m128i cdgh_save = state1;
+
+    __m128i msgs[4];
+    for (int i = 0; i < 4; i++) {
+      msgs[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+          byte_swap);
+    }
+
+    // Four rounds per iteration. msgs[i % 4] holds words 4i..4i+3 of the
+    // message schedule, and is replaced by words 4(i+4).. once used.
+#pragma GCC unroll 16
+    for (int i = 0; i < 16; i++) {
+      __m128i msg = _mm_add_epi32(
+          msgs[i & 3],
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kSha256K[4 * i])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+      if (i < 12) {
+        __m128i w7 = _mm_alignr_epi8(msgs[(i + 3) & 3], msgs[(i + 2) & 3], 4);
+        __m128i next = _mm_add_epi32(
+            _mm_sha256msg1_epu32(msgs[i & 3], msgs[(i + 1) & 3]), w7);
+        msgs[i & 3] = _mm_sha256msg2_epu32(next, msgs[(i + 3) & 3]);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+  state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+  state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+}  // namespace
+
+namespace igasync::sample::detail {
+
+void sha256_batch_shani(std::span<const std::span<const std::byte>> inputs,
+                        std::span<Sha256Digest> outputs) {
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const auto* data = reinterpret_cast<const uint8_t*>(inputs[i].data());
+    size_t full_blocks = inputs[i].size() / 64;
+
+    uint32_t state[8];
+    std::copy(std::begin(kSha256H0), std::end(kSha256H0), state);
+    ::compress_blocks(state, data, full_blocks);
+
+    uint8_t tail[128];
+    size_t tail_blocks =
+        write_padded_tail(tail, data + full_blocks * 64, inputs[i].size());
+    ::compress_blocks(state, tail, tail_blocks);
+
+    for (size_t w = 0; w < 8; w++) {
+      store_be32(outputs[i].data() + 4 * w, state[w]);
+    }
+  }
+}
+
+}  // namespace igasync::sample::detail
@@ -0,0 +1,42 @@
+#include <emmintrin.h>
+
+#include "sha256_batch_internal.h"
+#include "sha256_multi_buffer.inl"
+
+namespace {
+struct Sse2Lanes {
+  using vec = __m128i;
+  static constexpr size_t kLanes = 4;
+
+  static vec load(const uint32_t* p) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static void store(uint32_t* p, vec v) {
+    _mm_store_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+  static vec set1(uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+  static vec add(vec a, vec b) { return _mm_add_epi32(a, b); }
+  static vec xor_(vec a, vec b) { return _mm_xor_si128(a, b); }
+  static vec and_(vec a, vec b) { return _mm_and_si128(a, b); }
+  static vec or_(vec a, vec b) { return _mm_or_si128(a, b); }
+  static vec andnot(vec a, vec b) { return _mm_andnot_si128(a, b); }
+
+  template <int N>
+  static vec shr(vec v) {
+    return _mm_srli_epi32(v, N);
+  }
+  template <int N>
+  static vec rotr(vec v) {
+    return _mm_or_si128(_mm_srli_epi32(v, N), _mm_slli_epi32(v, 32 - N));
+  }
+};
+}  // namespace
+
+namespace igasync::sample::detail {
+
+void sha256_batch_sse2x4(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs) {
+  sha256_multi_buffer<::Sse2Lanes>(inputs, outputs);
+}
+
+}  // namespace igasync::sample::detail
@@ -0,0 +1,251 @@
+#ifndef IGASYNC_SAMPLES_READ_FILE_SHA256_SHA256_MULTI_BUFFER_INL
+#define IGASYNC_SAMPLES_READ_FILE_SHA256_SHA256_MULTI_BUFFER_INL
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "sha256_batch.h"
+
+// Included by each implementation's translation unit - everything here has
+// internal linkage, so code compiled with different instruction sets is never
+// merged by the linker.
+namespace igasync::sample::detail {
+namespace {
+
+constexpr uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr uint32_t kSha256H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+inline uint32_t load_be32(const uint8_t* p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline void store_be32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v >> 24);
+  p[1] = static_cast<uint8_t>(v >> 16);
+  p[2] = static_cast<uint8_t>(v >> 8);
+  p[3] = static_cast<uint8_t>(v);
+}
+
+/**
+ * @brief Write the final (padded) block or two of a message to tail
+ * @param rest The trailing message bytes that don't fill a whole block
+ * @param total_size Size of the whole message in bytes
+ * @return Number of blocks written to tail (1 or 2)
+ */
+inline size_t write_padded_tail(uint8_t (&tail)[128], const uint8_t* rest,
+                                size_t total_size) {
+  size_t rest_size = total_size % 64;
+  size_t tail_blocks = rest_size + 9 <= 64 ? 1 : 2;
+
+  if (rest_size > 0) {
+    std::memcpy(tail, rest, rest_size);
+  }
+  tail[rest_size] = 0x80;
+  std::memset(tail + rest_size + 1, 0, tail_blocks * 64 - rest_size - 1 - 8);
+
+  uint64_t bit_size = static_cast<uint64_t>(total_size) * 8;
+  uint8_t* size_out = tail + tail_blocks * 64 - 8;
+  store_be32(size_out, static_cast<uint32_t>(bit_size >> 32));
+  store_be32(size_out + 4, static_cast<uint32_t>(bit_size));
+
+  return tail_blocks;
+}
+
+/**
+ * @brief One SHA-256 compression step on V::kLanes independent states, where
+ *        state[i][lane] is word i of that lane's state.
+ *
+ * V provides a vector type with one 32-bit element per lane and the handful
+ * of element-wise operations SHA-256 needs.
+ */
+template <class V>
+void compress_lanes(uint32_t (&state)[8][V::kLanes],
+                    const uint8_t* const (&blocks)[V::kLanes]) {
+  using vec = typename V::vec;
+
+  // Transpose the message words so that each vector holds word t of every
+  // lane's block
+  alignas(32) uint32_t words[16][V::kLanes];
+  for (size_t lane = 0; lane < V::kLanes; lane++) {
+    for (size_t t = 0; t < 16; t++) {
+      words[t][lane] = load_be32(blocks[lane] + 4 * t);
+    }
+  }
+
+  vec w[16];
+  for (size_t t = 0; t < 16; t++) {
+    w[t] = V::load(words[t]);
+  }
+
+  vec a = V::load(state[0]), b = V::load(state[1]), c = V::load(state[2]),
+      d = V::load(state[3]), e = V::load(state[4]), f = V::load(state[5]),
+      g = V::load(state[6]), h = V::load(state[7]);
+
+  for (size_t t = 0; t < 64; t++) {
+    if (t >= 16) {
+      vec w2 = w[(t - 2) & 15];
+      vec w15 = w[(t - 15) & 15];
+      vec s0 = V::xor_(V::xor_(V::template rotr<7>(w15),
+                               V::template rotr<18>(w15)),
+                       V::template shr<3>(w15));
+      vec s1 = V::xor_(V::xor_(V::template rotr<17>(w2),
+                               V::template rotr<19>(w2)),
+                       V::template shr<10>(w2));
+      w[t & 15] = V::add(V::add(w[t & 15], s0), V::add(w[(t - 7) & 15], s1));
+    }
+
+    vec big_s1 = V::xor_(
+        V::xor_(V::template rotr<6>(e), V::template rotr<11>(e)),
+        V::template rotr<25>(e));
+    vec ch = V::xor_(V::and_(e, f), V::andnot(e, g));
+    vec t1 = V::add(V::add(V::add(h, big_s1), V::add(ch, V::set1(kSha256K[t]))),
+                    w[t & 15]);
+
+    vec big_s0 = V::xor_(
+        V::xor_(V::template rotr<2>(a), V::template rotr<13>(a)),
+        V::template rotr<22>(a));
+    vec maj = V::or_(V::and_(a, b), V::and_(c, V::or_(a, b)));
+    vec t2 = V::add(big_s0, maj);
+
+    h = g;
+    g = f;
+    f = e;
+    e = V::add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = V::add(t1, t2);
+  }
+
+  V::store(state[0], V::add(V::load(state[0]), a));
+  V::store(state[1], V::add(V::load(state[1]), b));
+  V::store(state[2], V::add(V::load(state[2]), c));
+  V::store(state[3], V::add(V::load(state[3]), d));
+  V::store(state[4], V::add(V::load(state[4]), e));
+  V::store(state[5], V::add(V::load(state[5]), f));
+  V::store(state[6], V::add(V::load(state[6]), g));
+  V::store(state[7], V::add(V::load(state[7]), h));
+}
+
+/**
+ * @brief Hash inputs V::kLanes at a time
+ *
+ * Every lane works through its own input block by block, and picks up the
+ * next unstarted input as soon as it finishes, so lanes stay busy even when
+ * input lengths differ. Inputs are started longest first so that all lanes
+ * tend to run dry at the same time; idle lanes hash a dummy block.
+ */
+template <class V>
+void sha256_multi_buffer(std::span<const std::span<const std::byte>> inputs,
+                         std::span<Sha256Digest> outputs) {
+  constexpr size_t kLanes = V::kLanes;
+
+  struct Lane {
+    bool IsActive{false};
+    size_t Input{0};
+    const uint8_t* Data{nullptr};
+    size_t FullBlocks{0};
+    size_t TailBlocks{0};
+    size_t NextBlock{0};
+    uint8_t Tail[128];
+  };
+
+  std::vector<size_t> order(inputs.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&inputs](size_t l, size_t r) {
+    return inputs[l].size() > inputs[r].size();
+  });
+
+  static const uint8_t kIdleBlock[64] = {};
+
+  Lane lanes[kLanes];
+  alignas(32) uint32_t state[8][kLanes];
+  size_t next_input = 0;
+
+  auto start_lane = [&](size_t lane_idx) {
+    Lane& lane = lanes[lane_idx];
+    if (next_input == order.size()) {
+      lane.IsActive = false;
+      return;
+    }
+
+    lane.IsActive = true;
+    lane.Input = order[next_input++];
+    const auto& input = inputs[lane.Input];
+    lane.Data = reinterpret_cast<const uint8_t*>(input.data());
+    lane.FullBlocks = input.size() / 64;
+    lane.NextBlock = 0;
+    lane.TailBlocks = write_padded_tail(
+        lane.Tail, lane.Data + lane.FullBlocks * 64, input.size());
+
+    for (size_t i = 0; i < 8; i++) {
+      state[i][lane_idx] = kSha256H0[i];
+    }
+  };
+
+  for (size_t lane = 0; lane < kLanes; lane++) {
+    start_lane(lane);
+  }
+
+  while (true) {
+    const uint8_t* blocks[kLanes];
+    bool is_any_active = false;
+    for (size_t lane_idx = 0; lane_idx < kLanes; lane_idx++) {
+      const Lane& lane = lanes[lane_idx];
+      if (!lane.IsActive) {
+        blocks[lane_idx] = kIdleBlock;
+        continue;
+      }
+
+      is_any_active = true;
+      blocks[lane_idx] =
+          lane.NextBlock < lane.FullBlocks
+              ? lane.Data + lane.NextBlock * 64
+              : lane.Tail + (lane.NextBlock - lane.FullBlocks) * 64;
+    }
+
+    if (!is_any_active) {
+      return;
+    }
+
+    compress_lanes<V>(state, blocks);
+
+    for (size_t lane_idx = 0; lane_idx < kLanes; lane_idx++) {
+      Lane& lane = lanes[lane_idx];
+      if (!lane.IsActive ||
+          ++lane.NextBlock < lane.FullBlocks + lane.TailBlocks) {
+        continue;
+      }
+
+      Sha256Digest& out = outputs[lane.Input];
+      for (size_t i = 0; i < 8; i++) {
+        store_be32(out.data() + 4 * i, state[i][lane_idx]);
+      }
+      start_lane(lane_idx);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace igasync::sample::detail
+
+#endif
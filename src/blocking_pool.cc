@@ -0,0 +1,139 @@
+#include <igasync/blocking_pool.h>
+#include <igasync/trace_recorder.h>
+
+#include <algorithm>
+
+using namespace igasync;
+
+std::shared_ptr<BlockingPool> BlockingPool::Create(BlockingPool::Desc desc) {
+  return std::shared_ptr<BlockingPool>(new BlockingPool(std::move(desc)));
+}
+
+std::shared_ptr<BlockingPool> BlockingPool::Default() {
+  static auto pool = BlockingPool::Create();
+  return pool;
+}
+
+BlockingPool::BlockingPool(BlockingPool::Desc desc)
+    : desc_(std::move(desc)),
+      idle_thread_count_(0),
+      next_thread_idx_(0),
+      is_stopping_(false) {
+  if (desc_.MaxThreads < 1) {
+    desc_.MaxThreads = 1;
+  }
+  if (desc_.MinThreads > desc_.MaxThreads) {
+    desc_.MinThreads = desc_.MaxThreads;
+  }
+
+  std::lock_guard l(m_threads_);
+  for (uint32_t i = 0; i < desc_.MinThreads; i++) {
+    start_thread();
+  }
+}
+
+BlockingPool::~BlockingPool() {
+  {
+    std::unique_lock l(m_threads_);
+    is_stopping_ = true;
+    cv_has_task_.notify_all();
+    cv_thread_exited_.wait(l, [this]() { return threads_.empty(); });
+  }
+
+  join_retired_threads();
+}
+
+void BlockingPool::schedule(std::unique_ptr<Task> task) {
+  join_retired_threads();
+
+  std::lock_guard l(m_threads_);
+  tasks_.push_back(std::move(task));
+
+  // Idle threads that were already woken up may not have taken their task
+  // yet, so only start a thread once queued tasks outnumber idle threads
+  if (tasks_.size() > idle_thread_count_ &&
+      threads_.size() < desc_.MaxThreads) {
+    start_thread();
+    return;
+  }
+
+  cv_has_task_.notify_one();
+}
+
+size_t BlockingPool::thread_count() const {
+  std::lock_guard l(m_threads_);
+  return threads_.size();
+}
+
+size_t BlockingPool::idle_thread_count() const {
+  std::lock_guard l(m_threads_);
+  return idle_thread_count_;
+}
+
+size_t BlockingPool::queued_task_count() const {
+  std::lock_guard l(m_threads_);
+  return tasks_.size();
+}
+
+void BlockingPool::start_thread() {
+  uint32_t thread_idx = next_thread_idx_++;
+  threads_.push_back(
+      std::thread([this, thread_idx]() { run_thread(thread_idx); }));
+}
+
+void BlockingPool::run_thread(uint32_t thread_idx) {
+  TraceRecorder::Get().set_thread_name(desc_.Name + " " +
+                                       std::to_string(thread_idx));
+
+  std::unique_lock l(m_threads_);
+  while (true) {
+    if (!tasks_.empty()) {
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      l.unlock();
+      task->run();
+      task = nullptr;
+      l.lock();
+      continue;
+    }
+
+    if (is_stopping_) {
+      break;
+    }
+
+    idle_thread_count_++;
+    bool has_work = cv_has_task_.wait_for(l, desc_.IdleTimeout, [this]() {
+      return !tasks_.empty() || is_stopping_;
+    });
+    idle_thread_count_--;
+
+    if (!has_work && threads_.size() > desc_.MinThreads) {
+      break;
+    }
+  }
+
+  // Threads can not join themselves - hand this one off to be joined by the
+  // next schedule() call or the destructor
+  auto self = std::find_if(
+      threads_.begin(), threads_.end(), [](const std::thread& t) {
+        return t.get_id() == std::this_thread::get_id();
+      });
+  retired_threads_.push_back(std::move(*self));
+  threads_.erase(self);
+  cv_thread_exited_.notify_all();
+}
+
+void BlockingPool::join_retired_threads() {
+  std::vector<std::thread> retired;
+  {
+    std::lock_guard l(m_threads_);
+    if (retired_threads_.empty()) {
+      return;
+    }
+    retired.swap(retired_threads_);
+  }
+
+  for (auto& t : retired) {
+    t.join();
+  }
+}
@@ -0,0 +1,125 @@
+#include <igasync/call_site_profiler.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+
+using namespace igasync;
+
+namespace {
+double to_us(std::chrono::nanoseconds ns) { return (double)ns.count() / 1000.; }
+}  // namespace
+
+std::atomic_bool CallSiteProfiler::is_enabled_ = false;
+
+CallSiteProfiler& CallSiteProfiler::Get() {
+  static CallSiteProfiler profiler;
+  return profiler;
+}
+
+size_t CallSiteProfiler::SiteKeyHash::operator()(const SiteKey& key) const {
+  // Name and file point to static strings, so identity is enough
+  size_t h = std::hash<const void*>()(key.Name);
+  h = h * 31 + std::hash<const void*>()(key.File);
+  h = h * 31 + key.Line;
+  h = h * 31 + key.Column;
+  return h;
+}
+
+void CallSiteProfiler::start() {
+  std::unique_lock l(m_sites_);
+  sites_.clear();
+  is_enabled_ = true;
+}
+
+void CallSiteProfiler::stop() { is_enabled_ = false; }
+
+void CallSiteProfiler::record(const TaskLabel& label,
+                              std::chrono::nanoseconds queue_wait,
+                              std::chrono::nanoseconds run_time) {
+  SiteKey key{label.Name, label.Location.file_name(), label.Location.line(),
+              label.Location.column()};
+
+  {
+    // Fast path - call site already known, histograms are lock-free
+    std::shared_lock l(m_sites_);
+    auto it = sites_.find(key);
+    if (it != sites_.end()) {
+      it->second->QueueWait.record(queue_wait);
+      it->second->RunTime.record(run_time);
+      return;
+    }
+  }
+
+  std::unique_lock l(m_sites_);
+  auto& site = sites_[key];
+  if (site == nullptr) {
+    site = std::make_unique<Site>();
+    site->Label = label;
+  }
+  site->QueueWait.record(queue_wait);
+  site->RunTime.record(run_time);
+}
+
+std::vector<CallSiteStats> CallSiteProfiler::snapshot() const {
+  std::vector<CallSiteStats> stats;
+
+  {
+    std::shared_lock l(m_sites_);
+    stats.reserve(sites_.size());
+    for (const auto& [key, site] : sites_) {
+      auto run_time = site->RunTime.snapshot();
+      auto queue_wait = site->QueueWait.snapshot();
+
+      CallSiteStats s;
+      s.Name = site->Label.Name;
+      s.File = site->Label.Location.file_name();
+      s.Function = site->Label.Location.function_name();
+      s.Line = site->Label.Location.line();
+      s.Count = run_time.Count;
+      s.TotalRunTime = std::chrono::nanoseconds(run_time.TotalNs);
+      s.RunTimeP50 = run_time.percentile(0.5);
+      s.RunTimeP99 = run_time.percentile(0.99);
+      s.TotalQueueWait = std::chrono::nanoseconds(queue_wait.TotalNs);
+      s.QueueWaitP50 = queue_wait.percentile(0.5);
+      s.QueueWaitP99 = queue_wait.percentile(0.99);
+      stats.push_back(s);
+    }
+  }
+
+  std::sort(stats.begin(), stats.end(),
+            [](const CallSiteStats& a, const CallSiteStats& b) {
+              return a.TotalRunTime > b.TotalRunTime;
+            });
+  return stats;
+}
+
+void CallSiteProfiler::write_report(std::ostream& out, size_t max_rows) const {
+  auto stats = snapshot();
+
+  out << std::fixed << std::setprecision(1);
+  out << std::setw(10) << "count" << std::setw(12) << "total us"
+      << std::setw(10) << "p50 us" << std::setw(10) << "p99 us"
+      << std::setw(12) << "wait p50" << std::setw(12) << "wait p99"
+      << "  call site\n";
+
+  for (size_t i = 0; i < stats.size() && i < max_rows; i++) {
+    const auto& s = stats[i];
+    out << std::setw(10) << s.Count << std::setw(12) << to_us(s.TotalRunTime)
+        << std::setw(10) << to_us(s.RunTimeP50) << std::setw(10)
+        << to_us(s.RunTimeP99) << std::setw(12) << to_us(s.QueueWaitP50)
+        << std::setw(12) << to_us(s.QueueWaitP99) << "  ";
+
+    if (s.Name != nullptr) {
+      out << s.Name << " ";
+    }
+    if (s.Line != 0) {
+      out << "(" << s.File << ":" << s.Line << ")";
+    } else if (s.Name == nullptr) {
+      out << "<unlabeled>";
+    }
+    out << "\n";
+  }
+
+  out << std::defaultfloat;
+}
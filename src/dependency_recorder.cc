@@ -0,0 +1,139 @@
+#include <igasync/dependency_recorder.h>
+#include <igasync/task.h>
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace igasync;
+
+namespace {
+double to_us(std::chrono::nanoseconds ns) { return (double)ns.count() / 1000.; }
+}  // namespace
+
+std::atomic_bool DependencyRecorder::is_recording_ = false;
+
+DependencyRecorder& DependencyRecorder::Get() {
+  static DependencyRecorder recorder;
+  return recorder;
+}
+
+void DependencyRecorder::start(size_t max_nodes) {
+  std::lock_guard l(m_nodes_);
+  nodes_.clear();
+  latest_node_.clear();
+  max_nodes_ = max_nodes;
+  is_recording_ = true;
+}
+
+void DependencyRecorder::stop() { is_recording_ = false; }
+
+void DependencyRecorder::on_promise_resolved(const void* promise) {
+  PromiseNode node;
+  node.Promise = promise;
+  node.ResolvedAt = std::chrono::high_resolution_clock::now();
+
+  const Task* task = Task::current();
+  if (task != nullptr) {
+    node.Predecessor = task->source_promise();
+    node.ProducerLabel = task->label();
+
+    auto scheduled = task->scheduled_at();
+    auto started = task->profile_data_.Started;
+    if (scheduled.time_since_epoch().count() == 0) {
+      scheduled = task->profile_data_.Created;
+    }
+    node.QueueWait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        started - scheduled);
+    node.RunTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        node.ResolvedAt - started);
+  }
+
+  std::lock_guard l(m_nodes_);
+  if (nodes_.size() >= max_nodes_) {
+    return;
+  }
+  latest_node_[promise] = nodes_.size();
+  nodes_.push_back(node);
+}
+
+std::vector<PromiseNode> DependencyRecorder::critical_path(
+    const void* promise) const {
+  std::vector<PromiseNode> path;
+
+  std::lock_guard l(m_nodes_);
+  auto it = latest_node_.find(promise);
+  if (it == latest_node_.end()) {
+    return path;
+  }
+
+  size_t idx = it->second;
+  while (true) {
+    const PromiseNode& node = nodes_[idx];
+    path.push_back(node);
+    if (node.Predecessor == nullptr) {
+      break;
+    }
+
+    // Only follow predecessors that resolved before this node - anything
+    // else is a newer promise that reused the predecessor's address
+    auto pred_it = latest_node_.find(node.Predecessor);
+    if (pred_it == latest_node_.end() || pred_it->second >= idx) {
+      break;
+    }
+    idx = pred_it->second;
+  }
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+void DependencyRecorder::write_report(std::ostream& out,
+                                      const void* promise) const {
+  auto path = critical_path(promise);
+  if (path.empty()) {
+    out << "No recorded resolution for promise " << promise << "\n";
+    return;
+  }
+
+  std::chrono::nanoseconds total_wait(0), total_run(0);
+
+  out << std::fixed << std::setprecision(1);
+  out << std::setw(12) << "delay us" << std::setw(12) << "wait us"
+      << std::setw(12) << "run us" << "  resolved by\n";
+  for (size_t i = 0; i < path.size(); i++) {
+    const PromiseNode& node = path[i];
+
+    // Time between the previous step resolving and this one resolving
+    auto delay = i == 0 ? std::chrono::nanoseconds(0)
+                        : std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              node.ResolvedAt - path[i - 1].ResolvedAt);
+    total_wait += node.QueueWait;
+    total_run += node.RunTime;
+
+    out << std::setw(12) << to_us(delay) << std::setw(12)
+        << to_us(node.QueueWait) << std::setw(12) << to_us(node.RunTime)
+        << "  ";
+    if (node.ProducerLabel.Name != nullptr) {
+      out << node.ProducerLabel.Name << " ";
+    }
+    if (node.ProducerLabel.Location.line() != 0) {
+      out << "(" << node.ProducerLabel.Location.file_name() << ":"
+          << node.ProducerLabel.Location.line() << ")";
+    } else if (node.ProducerLabel.Name == nullptr) {
+      out << (node.Predecessor == nullptr ? "<external>" : "<unlabeled>");
+    }
+    out << "\n";
+  }
+
+  auto span = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      path.back().ResolvedAt - path.front().ResolvedAt);
+  out << "Critical path: " << path.size() << " steps, " << to_us(span)
+      << " us (" << to_us(total_wait) << " us queued, " << to_us(total_run)
+      << " us running)\n";
+  out << std::defaultfloat;
+}
+
+size_t DependencyRecorder::node_count() const {
+  std::lock_guard l(m_nodes_);
+  return nodes_.size();
+}
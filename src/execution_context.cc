@@ -0,0 +1,32 @@
+#include <igasync/execution_context.h>
+
+#include <algorithm>
+
+using namespace igasync;
+
+void igasync::schedule_grouped(std::vector<ContextTask> tasks) {
+  std::vector<std::pair<std::shared_ptr<ExecutionContext>,
+                        std::vector<std::unique_ptr<Task>>>>
+      batches;
+
+  for (auto& task : tasks) {
+    if (task.Context == nullptr) {
+      task.Run->run();
+      continue;
+    }
+
+    auto batch = std::find_if(
+        batches.begin(), batches.end(),
+        [&task](const auto& batch) { return batch.first == task.Context; });
+    if (batch == batches.end()) {
+      batches.emplace_back(std::move(task.Context),
+                           std::vector<std::unique_ptr<Task>>());
+      batch = batches.end() - 1;
+    }
+    batch->second.push_back(std::move(task.Run));
+  }
+
+  for (auto& [context, batch_tasks] : batches) {
+    context->schedule_bulk(std::move(batch_tasks));
+  }
+}
@@ -0,0 +1,83 @@
+#include <igasync/instrumentation.h>
+
+using namespace igasync;
+
+std::atomic_size_t Instrumentation::observer_count_ = 0;
+std::array<std::atomic<IInstrumentationObserver*>,
+           Instrumentation::kMaxObservers>
+    Instrumentation::observers_{};
+
+bool Instrumentation::add_observer(IInstrumentationObserver* observer) {
+  for (auto& slot : observers_) {
+    IInstrumentationObserver* expected = nullptr;
+    if (slot.compare_exchange_strong(expected, observer,
+                                     std::memory_order_acq_rel)) {
+      observer_count_.fetch_add(1, std::memory_order_release);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Instrumentation::remove_observer(IInstrumentationObserver* observer) {
+  for (auto& slot : observers_) {
+    IInstrumentationObserver* expected = observer;
+    if (slot.compare_exchange_strong(expected, nullptr,
+                                     std::memory_order_acq_rel)) {
+      observer_count_.fetch_sub(1, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+template <typename F>
+void Instrumentation::for_each_observer(F&& f) {
+  if (observer_count_.load(std::memory_order_acquire) == 0) {
+    return;
+  }
+
+  for (auto& slot : observers_) {
+    IInstrumentationObserver* observer = slot.load(std::memory_order_acquire);
+    if (observer != nullptr) {
+      f(*observer);
+    }
+  }
+}
+
+void Instrumentation::task_scheduled(
+    const Task& task, const ExecutionContext& execution_context) {
+  for_each_observer([&](IInstrumentationObserver& o) {
+    o.on_task_scheduled(task, execution_context);
+  });
+}
+
+void Instrumentation::task_started(const Task& task) {
+  for_each_observer(
+      [&](IInstrumentationObserver& o) { o.on_task_started(task); });
+}
+
+void Instrumentation::task_finished(const Task& task) {
+  for_each_observer(
+      [&](IInstrumentationObserver& o) { o.on_task_finished(task); });
+}
+
+void Instrumentation::promise_created(const void* promise) {
+  for_each_observer(
+      [&](IInstrumentationObserver& o) { o.on_promise_created(promise); });
+}
+
+void Instrumentation::promise_resolved(const void* promise) {
+  for_each_observer(
+      [&](IInstrumentationObserver& o) { o.on_promise_resolved(promise); });
+}
+
+void Instrumentation::worker_parked(size_t worker_idx) {
+  for_each_observer(
+      [&](IInstrumentationObserver& o) { o.on_worker_parked(worker_idx); });
+}
+
+void Instrumentation::worker_unparked(size_t worker_idx) {
+  for_each_observer(
+      [&](IInstrumentationObserver& o) { o.on_worker_unparked(worker_idx); });
+}
@@ -0,0 +1,111 @@
+#include <igasync/job_scheduler.h>
+
+#include <algorithm>
+
+using namespace igasync;
+
+JobScheduler::JobScheduler() : graph_(TaskGraph::Create()) {}
+
+std::shared_ptr<JobScheduler> JobScheduler::Create() {
+  return std::shared_ptr<JobScheduler>(new JobScheduler());
+}
+
+JobScheduler::ResourceId JobScheduler::resource(const std::string& name) {
+  std::lock_guard l(m_jobs_);
+  auto it = resource_ids_.find(name);
+  if (it != resource_ids_.end()) {
+    return it->second;
+  }
+
+  ResourceId id = static_cast<ResourceId>(resources_.size());
+  resources_.push_back({0, false, {}});
+  resource_ids_.emplace(name, id);
+  return id;
+}
+
+JobScheduler::JobId JobScheduler::add_job(std::function<void()> fn,
+                                          std::vector<ResourceId> reads,
+                                          std::vector<ResourceId> writes) {
+  std::lock_guard l(m_jobs_);
+  JobId job = graph_->add_node(std::move(fn));
+
+  // Unknown resources (not from resource()) are left out of the schedule
+  auto is_unknown = [this](ResourceId r) { return r >= resources_.size(); };
+  if (std::any_of(reads.begin(), reads.end(), is_unknown) ||
+      std::any_of(writes.begin(), writes.end(), is_unknown)) {
+    // TODO (sessamekesh): Invoke error callback for invalid resource IDs
+    reads.erase(std::remove_if(reads.begin(), reads.end(), is_unknown),
+                reads.end());
+    writes.erase(std::remove_if(writes.begin(), writes.end(), is_unknown),
+                 writes.end());
+  }
+
+  // A job that both reads and writes a resource only needs the write edges
+  std::sort(writes.begin(), writes.end());
+  writes.erase(std::unique(writes.begin(), writes.end()), writes.end());
+  reads.erase(std::remove_if(reads.begin(), reads.end(),
+                             [&writes](ResourceId r) {
+                               return std::binary_search(writes.begin(),
+                                                         writes.end(), r);
+                             }),
+              reads.end());
+
+  std::vector<JobId> deps;
+  for (ResourceId r : reads) {
+    ResourceState& state = resources_[r];
+    if (state.HasWriter) {
+      deps.push_back(state.LastWriter);
+    }
+  }
+
+  for (ResourceId r : writes) {
+    ResourceState& state = resources_[r];
+
+    // Readers since the last write already wait on that writer, so they are
+    // enough to order this job after both
+    if (!state.ReadersSinceWrite.empty()) {
+      deps.insert(deps.end(), state.ReadersSinceWrite.begin(),
+                  state.ReadersSinceWrite.end());
+    } else if (state.HasWriter) {
+      deps.push_back(state.LastWriter);
+    }
+  }
+
+  std::sort(deps.begin(), deps.end());
+  deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+  deps.erase(std::remove(deps.begin(), deps.end(), job), deps.end());
+  for (JobId dep : deps) {
+    graph_->add_edge(dep, job);
+  }
+
+  for (ResourceId r : reads) {
+    resources_[r].ReadersSinceWrite.push_back(job);
+  }
+  for (ResourceId r : writes) {
+    ResourceState& state = resources_[r];
+    state.LastWriter = job;
+    state.HasWriter = true;
+    state.ReadersSinceWrite.clear();
+  }
+
+  if (dependencies_.size() <= job) {
+    dependencies_.resize(job + 1);
+  }
+  dependencies_[job] = std::move(deps);
+
+  return job;
+}
+
+std::vector<JobScheduler::JobId> JobScheduler::dependencies_of(
+    JobId job) const {
+  std::lock_guard l(m_jobs_);
+  if (job >= dependencies_.size()) {
+    return {};
+  }
+  return dependencies_[job];
+}
+
+std::shared_ptr<Promise<void>> JobScheduler::execute(
+    std::shared_ptr<ExecutionContext> execution_context) {
+  return graph_->execute(std::move(execution_context));
+}
@@ -0,0 +1,117 @@
+#include <igasync/metrics.h>
+
+#include <bit>
+
+using namespace igasync;
+
+size_t LatencyHistogram::bucket_index(uint64_t ns) {
+  if (ns < kSubBucketCount) {
+    return static_cast<size_t>(ns);
+  }
+
+  // Top kSubBucketBits+1 significant bits select the bucket
+  size_t magnitude = 63 - std::countl_zero(ns);
+  size_t shift = magnitude - kSubBucketBits;
+  size_t sub_bucket = static_cast<size_t>(ns >> shift) - kSubBucketCount;
+  return (shift + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_lower_bound(size_t idx) {
+  if (idx < kSubBucketCount) {
+    return idx;
+  }
+
+  size_t shift = idx / kSubBucketCount - 1;
+  uint64_t sub_bucket = idx % kSubBucketCount;
+  return (kSubBucketCount + sub_bucket) << shift;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) {
+  uint64_t ns = latency.count() < 0 ? 0 : static_cast<uint64_t>(latency.count());
+
+  buckets_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(ns, std::memory_order_relaxed);
+
+  uint64_t prev_max = max_ns_.load(std::memory_order_relaxed);
+  while (prev_max < ns && !max_ns_.compare_exchange_weak(
+                              prev_max, ns, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+  Snapshot s;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    s.Buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    s.Count += s.Buckets[i];
+  }
+
+  // Count is summed from the buckets so that percentiles stay self-consistent
+  // with a snapshot taken while other threads are recording
+  s.TotalNs = total_ns_.load(std::memory_order_relaxed);
+  s.MaxNs = max_ns_.load(std::memory_order_relaxed);
+  return s;
+}
+
+void LatencyHistogram::reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  total_ns_.store(0, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::percentile(
+    double quantile) const {
+  if (Count == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+
+  quantile = quantile < 0. ? 0. : (quantile > 1. ? 1. : quantile);
+  uint64_t target = static_cast<uint64_t>(quantile * (double)(Count - 1)) + 1;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += Buckets[i];
+    if (seen >= target) {
+      // Report the upper edge of the bucket, clamped to the largest sample
+      uint64_t upper = i + 1 < kBucketCount ? bucket_lower_bound(i + 1) - 1
+                                            : UINT64_MAX;
+      return std::chrono::nanoseconds(
+          static_cast<int64_t>(upper < MaxNs ? upper : MaxNs));
+    }
+  }
+
+  return max();
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::mean() const {
+  if (Count == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::nanoseconds(static_cast<int64_t>(TotalNs / Count));
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::max() const {
+  return std::chrono::nanoseconds(static_cast<int64_t>(MaxNs));
+}
+
+uint64_t ThreadPoolMetrics::total_tasks_executed() const {
+  uint64_t total = 0;
+  for (const auto& worker : Workers) {
+    total += worker.TasksExecuted;
+  }
+  return total;
+}
+
+double ThreadPoolMetrics::utilization() const {
+  std::chrono::nanoseconds busy(0), total(0);
+  for (const auto& worker : Workers) {
+    busy += worker.BusyTime;
+    total += worker.BusyTime + worker.IdleTime;
+  }
+
+  if (total.count() == 0) {
+    return 0.;
+  }
+  return (double)busy.count() / (double)total.count();
+}
@@ -0,0 +1,76 @@
+#include <igasync/parallel.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace igasync;
+
+namespace {
+// Chunks per thread that an automatic grain size aims for - enough slack that
+// a worker that gets descheduled doesn't hold up the whole loop.
+const size_t kAutoChunksPerThread = 8;
+
+// Chunks that an automatic grain size aims for in deterministic mode, where
+// chunking can't depend on the thread count.
+const size_t kAutoDeterministicChunks = 256;
+}  // namespace
+
+RangePartitioner::RangePartitioner(size_t size, const ParallelDesc& desc)
+    : size_(size),
+      concurrency_(desc.Concurrency),
+      grain_size_(desc.GrainSize),
+      is_deterministic_(desc.Deterministic),
+      next_(0),
+      remaining_(size) {
+  if (concurrency_ == 0) {
+    concurrency_ = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  if (grain_size_ == 0) {
+    size_t target_chunks = is_deterministic_
+                               ? kAutoDeterministicChunks
+                               : concurrency_ * kAutoChunksPerThread;
+    grain_size_ = std::max<size_t>(size_ / target_chunks, 1);
+  }
+}
+
+bool RangePartitioner::claim(size_t& chunk_begin, size_t& chunk_end) {
+  size_t next = next_.load(std::memory_order_relaxed);
+  while (next < size_) {
+    size_t unclaimed = size_ - next;
+    size_t chunk_size =
+        is_deterministic_
+            ? grain_size_
+            : std::max(unclaimed / (concurrency_ * 2), grain_size_);
+    chunk_size = std::min(chunk_size, unclaimed);
+
+    if (next_.compare_exchange_weak(next, next + chunk_size,
+                                    std::memory_order_relaxed)) {
+      chunk_begin = next;
+      chunk_end = next + chunk_size;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool RangePartitioner::complete(size_t count) {
+  return remaining_.fetch_sub(count, std::memory_order_acq_rel) == count;
+}
+
+size_t RangePartitioner::helper_count(bool caller_participates) const {
+  size_t max_chunks = (size_ + grain_size_ - 1) / grain_size_;
+  size_t helpers = std::min(concurrency_, max_chunks);
+
+  if (caller_participates && helpers > 0) {
+    helpers--;
+  }
+
+  // Someone has to do the work!
+  if (!caller_participates && helpers == 0) {
+    helpers = 1;
+  }
+
+  return helpers;
+}
@@ -0,0 +1,133 @@
+#include <igasync/promise_census.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <tuple>
+
+using namespace igasync;
+
+std::atomic_bool PromiseCensus::is_enabled_ = false;
+
+PromiseCensus& PromiseCensus::Get() {
+  static PromiseCensus census;
+  return census;
+}
+
+void PromiseCensus::enable() { is_enabled_ = true; }
+
+void PromiseCensus::disable() { is_enabled_ = false; }
+
+PromiseCensus::Entry* PromiseCensus::add(const void* promise,
+                                         std::source_location location) {
+  Entry* entry = new Entry();
+  entry->Promise = promise;
+  entry->Location = location;
+  entry->CreatedAt = std::chrono::steady_clock::now();
+
+  std::lock_guard l(m_entries_);
+  entries_.insert(entry);
+  return entry;
+}
+
+void PromiseCensus::remove(Entry* entry) {
+  {
+    std::lock_guard l(m_entries_);
+    entries_.erase(entry);
+  }
+  delete entry;
+}
+
+std::vector<LivePromiseInfo> PromiseCensus::snapshot(
+    bool include_resolved) const {
+  auto now = std::chrono::steady_clock::now();
+  std::vector<LivePromiseInfo> infos;
+
+  {
+    std::lock_guard l(m_entries_);
+    infos.reserve(entries_.size());
+    for (const Entry* entry : entries_) {
+      bool is_resolved = entry->IsResolved.load(std::memory_order_relaxed);
+      if (is_resolved && !include_resolved) {
+        continue;
+      }
+
+      LivePromiseInfo info;
+      info.Promise = entry->Promise;
+      info.Location = entry->Location;
+      info.Age = now - entry->CreatedAt;
+      info.IsResolved = is_resolved;
+      info.PendingContinuations =
+          entry->PendingContinuations.load(std::memory_order_relaxed);
+      info.CapturedBytes = entry->CapturedBytes.load(std::memory_order_relaxed);
+      infos.push_back(info);
+    }
+  }
+
+  std::sort(infos.begin(), infos.end(),
+            [](const LivePromiseInfo& a, const LivePromiseInfo& b) {
+              return a.Age > b.Age;
+            });
+  return infos;
+}
+
+void PromiseCensus::write_report(std::ostream& out,
+                                 std::chrono::nanoseconds min_age) const {
+  struct SiteSummary {
+    std::source_location Location;
+    size_t Count{0};
+    size_t PendingContinuations{0};
+    size_t CapturedBytes{0};
+    std::chrono::nanoseconds OldestAge{0};
+  };
+
+  // Locations hold pointers to static strings, so identity is enough to group
+  std::map<std::tuple<const char*, uint32_t, uint32_t>, SiteSummary> sites;
+  for (const auto& info : snapshot()) {
+    if (info.Age < min_age) {
+      continue;
+    }
+
+    auto& site = sites[{info.Location.file_name(), info.Location.line(),
+                        info.Location.column()}];
+    site.Location = info.Location;
+    site.Count++;
+    site.PendingContinuations += info.PendingContinuations;
+    site.CapturedBytes += info.CapturedBytes;
+    site.OldestAge = std::max(site.OldestAge, info.Age);
+  }
+
+  std::vector<SiteSummary> summaries;
+  for (const auto& [key, site] : sites) {
+    summaries.push_back(site);
+  }
+  std::sort(summaries.begin(), summaries.end(),
+            [](const SiteSummary& a, const SiteSummary& b) {
+              return a.Count > b.Count;
+            });
+
+  out << std::fixed << std::setprecision(1);
+  out << std::setw(10) << "pending" << std::setw(10) << "thens"
+      << std::setw(12) << "bytes" << std::setw(12) << "oldest s"
+      << "  created at\n";
+  for (const auto& site : summaries) {
+    out << std::setw(10) << site.Count << std::setw(10)
+        << site.PendingContinuations << std::setw(12) << site.CapturedBytes
+        << std::setw(12)
+        << std::chrono::duration<double>(site.OldestAge).count() << "  ";
+    if (site.Location.line() != 0) {
+      out << site.Location.file_name() << ":" << site.Location.line() << " ("
+          << site.Location.function_name() << ")";
+    } else {
+      out << "<unknown>";
+    }
+    out << "\n";
+  }
+  out << std::defaultfloat;
+}
+
+size_t PromiseCensus::live_count() const {
+  std::lock_guard l(m_entries_);
+  return entries_.size();
+}
@@ -1,4 +1,5 @@
 #include <igasync/promise_combiner.h>
+#include <igasync/usdt.h>
 using namespace igasync;
 
 PromiseCombiner::Result& PromiseCombiner::Result::operator=(
@@ -52,6 +53,7 @@ void PromiseCombiner::resolve_promise(uint16_t key) {
     }
   }
 
+  IGASYNC_PROBE2(combiner__complete, this, entries_.size());
   final_promise_->resolve(std::move(result_));
 }
 
@@ -0,0 +1,346 @@
+#include <igasync/reactor.h>
+#include <igasync/trace_recorder.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace igasync;
+
+#if defined(__linux__)
+
+namespace {
+std::vector<epoll_event>& event_buffer(uint32_t size) {
+  thread_local std::vector<epoll_event> events;
+  if (events.size() < size) {
+    events.resize(size);
+  }
+  return events;
+}
+
+ssize_t write_fd(int fd, const std::byte* data, size_t size) {
+  ssize_t rsl = ::send(fd, data, size, MSG_NOSIGNAL);
+  if (rsl < 0 && errno == ENOTSOCK) {
+    rsl = ::write(fd, data, size);
+  }
+  return rsl;
+}
+}  // namespace
+
+std::shared_ptr<Reactor> Reactor::Create(Reactor::Desc desc) {
+  int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    return nullptr;
+  }
+
+  int wake_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wake_fd < 0) {
+    ::close(epoll_fd);
+    return nullptr;
+  }
+
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = wake_fd;
+  if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev) < 0) {
+    ::close(wake_fd);
+    ::close(epoll_fd);
+    return nullptr;
+  }
+
+  return std::shared_ptr<Reactor>(
+      new Reactor(std::move(desc), epoll_fd, wake_fd));
+}
+
+Reactor::Reactor(Reactor::Desc desc, int epoll_fd, int wake_fd)
+    : desc_(std::move(desc)),
+      epoll_fd_(epoll_fd),
+      wake_fd_(wake_fd),
+      is_stopping_(false) {
+  if (desc_.MaxEventsPerPoll < 1) {
+    desc_.MaxEventsPerPoll = 1;
+  }
+
+  if (desc_.UseDedicatedThread) {
+    reactor_thread_ = std::thread([this]() { run_thread(); });
+  }
+}
+
+Reactor::~Reactor() {
+  is_stopping_ = true;
+  uint64_t one = 1;
+  (void)::write(wake_fd_, &one, sizeof(one));
+  if (reactor_thread_.joinable()) {
+    reactor_thread_.join();
+  }
+
+  ::close(epoll_fd_);
+  ::close(wake_fd_);
+}
+
+std::shared_ptr<Promise<void>> Reactor::when_readable(
+    int fd, std::shared_ptr<ExecutionContext> completion_context) {
+  Waiter waiter;
+  waiter.Kind = Waiter::Op::Ready;
+  waiter.ReadyResult = Promise<void>::Create();
+  waiter.CompletionContext = std::move(completion_context);
+  auto rsl = waiter.ReadyResult;
+
+  add_waiter(fd, false, std::move(waiter));
+  return rsl;
+}
+
+std::shared_ptr<Promise<void>> Reactor::when_writable(
+    int fd, std::shared_ptr<ExecutionContext> completion_context) {
+  Waiter waiter;
+  waiter.Kind = Waiter::Op::Ready;
+  waiter.ReadyResult = Promise<void>::Create();
+  waiter.CompletionContext = std::move(completion_context);
+  auto rsl = waiter.ReadyResult;
+
+  add_waiter(fd, true, std::move(waiter));
+  return rsl;
+}
+
+std::shared_ptr<Promise<size_t>> Reactor::read_some(
+    int fd, std::span<std::byte> buffer,
+    std::shared_ptr<ExecutionContext> completion_context) {
+  Waiter waiter;
+  waiter.Kind = Waiter::Op::Read;
+  waiter.Data = buffer.data();
+  waiter.Size = buffer.size();
+  waiter.SizeResult = Promise<size_t>::Create();
+  waiter.CompletionContext = std::move(completion_context);
+  auto rsl = waiter.SizeResult;
+
+  add_waiter(fd, false, std::move(waiter));
+  return rsl;
+}
+
+std::shared_ptr<Promise<size_t>> Reactor::write_some(
+    int fd, std::span<const std::byte> data,
+    std::shared_ptr<ExecutionContext> completion_context) {
+  Waiter waiter;
+  waiter.Kind = Waiter::Op::Write;
+  // Only ever passed on to write()
+  waiter.Data = const_cast<std::byte*>(data.data());
+  waiter.Size = data.size();
+  waiter.SizeResult = Promise<size_t>::Create();
+  waiter.CompletionContext = std::move(completion_context);
+  auto rsl = waiter.SizeResult;
+
+  add_waiter(fd, true, std::move(waiter));
+  return rsl;
+}
+
+void Reactor::remove(int fd) {
+  std::lock_guard l(m_fds_);
+  auto it = fds_.find(fd);
+  if (it == fds_.end()) {
+    return;
+  }
+
+  if (it->second.IsRegistered) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  }
+  fds_.erase(it);
+}
+
+size_t Reactor::poll(std::chrono::milliseconds timeout) {
+  auto& events = ::event_buffer(desc_.MaxEventsPerPoll);
+  int timeout_ms =
+      timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+  int num_events = ::epoll_wait(epoll_fd_, events.data(),
+                                static_cast<int>(desc_.MaxEventsPerPoll),
+                                timeout_ms);
+  if (num_events <= 0) {
+    return 0;
+  }
+
+  std::vector<ContextTask> completions;
+  {
+    std::lock_guard l(m_fds_);
+    for (int i = 0; i < num_events; i++) {
+      int fd = events[i].data.fd;
+      uint32_t ev = events[i].events;
+
+      if (fd == wake_fd_) {
+        uint64_t value;
+        (void)::read(wake_fd_, &value, sizeof(value));
+        continue;
+      }
+
+      auto it = fds_.find(fd);
+      if (it == fds_.end()) {
+        continue;
+      }
+
+      // Registrations are one-shot - the fd stays disarmed until arm() below
+      FdState& state = it->second;
+      if (ev & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP)) {
+        serve(fd, state.Readers, completions);
+      }
+      if (ev & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+        serve(fd, state.Writers, completions);
+      }
+      arm(fd, state, completions);
+    }
+  }
+
+  size_t num_completed = completions.size();
+  schedule_grouped(std::move(completions));
+  return num_completed;
+}
+
+size_t Reactor::watched_fd_count() const {
+  std::lock_guard l(m_fds_);
+  size_t count = 0;
+  for (const auto& [fd, state] : fds_) {
+    if (!state.Readers.empty() || !state.Writers.empty()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void Reactor::add_waiter(int fd, bool is_write, Reactor::Waiter waiter) {
+  std::vector<ContextTask> completions;
+  {
+    std::lock_guard l(m_fds_);
+    FdState& state = fds_[fd];
+    (is_write ? state.Writers : state.Readers).push_back(std::move(waiter));
+    arm(fd, state, completions);
+  }
+  schedule_grouped(std::move(completions));
+}
+
+void Reactor::arm(int fd, Reactor::FdState& state,
+                  std::vector<ContextTask>& completions) {
+  uint32_t events = 0;
+  if (!state.Readers.empty()) {
+    events |= EPOLLIN | EPOLLRDHUP;
+  }
+  if (!state.Writers.empty()) {
+    events |= EPOLLOUT;
+  }
+  if (events == 0) {
+    return;
+  }
+
+  epoll_event ev{};
+  ev.events = events | EPOLLONESHOT;
+  ev.data.fd = fd;
+
+  int op = state.IsRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  int rsl = ::epoll_ctl(epoll_fd_, op, fd, &ev);
+  if (rsl < 0 && errno == ENOENT) {
+    // Closing an fd drops its registration - this number has been reused
+    rsl = ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+  } else if (rsl < 0 && errno == EEXIST) {
+    rsl = ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+  }
+
+  if (rsl == 0) {
+    state.IsRegistered = true;
+    return;
+  }
+
+  // epoll refuses descriptors that are always ready (regular files), and
+  // invalid ones - either way, waiting longer will not change the outcome
+  state.IsRegistered = false;
+  while (serve(fd, state.Readers, completions))
+    ;
+  while (serve(fd, state.Writers, completions))
+    ;
+}
+
+bool Reactor::serve(int fd, std::deque<Waiter>& waiters,
+                    std::vector<ContextTask>& completions) {
+  bool has_served = false;
+  while (!waiters.empty()) {
+    Waiter& waiter = waiters.front();
+    if (waiter.Kind == Waiter::Op::Ready) {
+      completions.push_back(
+          {std::move(waiter.CompletionContext),
+           Task::Of([rsl = std::move(waiter.ReadyResult)]() {
+             rsl->resolve();
+           })});
+      waiters.pop_front();
+      has_served = true;
+      continue;
+    }
+
+    ssize_t rsl = waiter.Kind == Waiter::Op::Read
+                      ? ::read(fd, waiter.Data, waiter.Size)
+                      : ::write_fd(fd, waiter.Data, waiter.Size);
+    if (rsl < 0 &&
+        (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      break;
+    }
+
+    size_t size = rsl < 0 ? 0 : static_cast<size_t>(rsl);
+    completions.push_back(
+        {std::move(waiter.CompletionContext),
+         Task::Of([rsl = std::move(waiter.SizeResult), size]() {
+           rsl->resolve(size);
+         })});
+    waiters.pop_front();
+    has_served = true;
+
+    // The fd may have no more data (or room) left, and a blocking descriptor
+    // would stall the reactor - wait for the next event to serve more
+    break;
+  }
+  return has_served;
+}
+
+void Reactor::run_thread() {
+  TraceRecorder::Get().set_thread_name(desc_.Name);
+
+  while (!is_stopping_) {
+    poll(std::chrono::milliseconds(-1));
+  }
+}
+
+#else
+
+std::shared_ptr<Reactor> Reactor::Create(Reactor::Desc desc) {
+  // TODO (sessamekesh): kqueue (macOS) and IOCP (Windows) backends
+  return nullptr;
+}
+
+Reactor::~Reactor() {}
+
+std::shared_ptr<Promise<void>> Reactor::when_readable(
+    int fd, std::shared_ptr<ExecutionContext> completion_context) {
+  return nullptr;
+}
+
+std::shared_ptr<Promise<void>> Reactor::when_writable(
+    int fd, std::shared_ptr<ExecutionContext> completion_context) {
+  return nullptr;
+}
+
+std::shared_ptr<Promise<size_t>> Reactor::read_some(
+    int fd, std::span<std::byte> buffer,
+    std::shared_ptr<ExecutionContext> completion_context) {
+  return nullptr;
+}
+
+std::shared_ptr<Promise<size_t>> Reactor::write_some(
+    int fd, std::span<const std::byte> data,
+    std::shared_ptr<ExecutionContext> completion_context) {
+  return nullptr;
+}
+
+void Reactor::remove(int fd) {}
+
+size_t Reactor::poll(std::chrono::milliseconds timeout) { return 0; }
+
+size_t Reactor::watched_fd_count() const { return 0; }
+
+#endif
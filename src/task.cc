@@ -1,19 +1,84 @@
+#include <igasync/call_site_profiler.h>
+#include <igasync/dependency_recorder.h>
+#include <igasync/instrumentation.h>
 #include <igasync/task.h>
 
 using namespace igasync;
 
+namespace {
+thread_local const Task* tls_current_task = nullptr;
+}
+
+Task::Task(std::function<void()>&& fn,
+           std::function<void(TaskProfile)> profile_cb, TaskLabel label)
+    : fn_(std::move(fn)),
+      profile_cb_(std::move(profile_cb)),
+      label_(label),
+      source_promise_(nullptr) {
+  profile_data_.Created = std::chrono::high_resolution_clock::now();
+  if (TraceRecorder::is_recording()) {
+    trace_ids_ = TraceRecorder::Get().on_task_created();
+  }
+}
+
 void Task::run() {
-  if (profile_cb_) {
+  IGASYNC_INSTRUMENT(task_started, *this);
+  bool is_tracing = TraceRecorder::is_recording();
+  bool is_profiling = CallSiteProfiler::is_enabled();
+  bool is_recording_deps = DependencyRecorder::is_recording();
+  if (profile_cb_ || is_tracing || is_profiling || is_recording_deps) {
+    if (is_tracing && trace_ids_.TaskId == 0) {
+      // Created before recording started - still record the run, but there is
+      // no creation event to draw a flow arrow from
+      trace_ids_ = TraceRecorder::Get().on_task_created();
+      trace_ids_.ParentTaskId = 0;
+    }
+
     profile_data_.ExecutorThreadId = std::this_thread::get_id();
     profile_data_.Started = std::chrono::high_resolution_clock::now();
+    uint64_t parent_task =
+        is_tracing ? TraceRecorder::set_current_task(trace_ids_.TaskId) : 0;
+    const Task* outer_task = std::exchange(tls_current_task, this);
     fn_();
+    tls_current_task = outer_task;
+    if (is_tracing) {
+      TraceRecorder::set_current_task(parent_task);
+    }
     profile_data_.Finished = std::chrono::high_resolution_clock::now();
-    profile_cb_(profile_data_);
+    if (profile_cb_) {
+      profile_cb_(profile_data_);
+    }
+    if (is_tracing) {
+      TraceRecorder::Get().record_task(
+          trace_ids_, profile_data_.Created, profile_data_.Scheduled,
+          profile_data_.Started, profile_data_.Finished);
+    }
+    if (is_profiling) {
+      // Tasks that never went through a TaskList were never marked scheduled
+      auto scheduled =
+          profile_data_.Scheduled.time_since_epoch().count() == 0
+              ? profile_data_.Created
+              : profile_data_.Scheduled;
+      CallSiteProfiler::Get().record(
+          label_, profile_data_.Started - scheduled,
+          profile_data_.Finished - profile_data_.Started);
+    }
   } else {
     fn_();
   }
+  IGASYNC_INSTRUMENT(task_finished, *this);
 }
 
 void Task::mark_scheduled() {
   profile_data_.Scheduled = std::chrono::high_resolution_clock::now();
 }
+
+std::chrono::high_resolution_clock::time_point Task::scheduled_at() const {
+  return profile_data_.Scheduled;
+}
+
+const TaskLabel& Task::label() const { return label_; }
+
+const void* Task::source_promise() const { return source_promise_; }
+
+const Task* Task::current() { return tls_current_task; }
@@ -0,0 +1,177 @@
+#include <igasync/task_graph.h>
+
+using namespace igasync;
+
+TaskGraph::TaskGraph() : is_compiled_(false), remaining_nodes_(0) {}
+
+std::shared_ptr<TaskGraph> TaskGraph::Create() {
+  return std::shared_ptr<TaskGraph>(new TaskGraph());
+}
+
+TaskGraph::NodeId TaskGraph::add_node(std::function<void()> fn) {
+  std::lock_guard l(m_graph_);
+  is_compiled_ = false;
+  decls_.push_back({std::move(fn), {}});
+  return static_cast<NodeId>(decls_.size() - 1);
+}
+
+void TaskGraph::add_edge(NodeId before, NodeId after) {
+  std::lock_guard l(m_graph_);
+  if (before >= decls_.size() || after >= decls_.size()) {
+    // TODO (sessamekesh): Invoke error callback for invalid node IDs
+    return;
+  }
+
+  is_compiled_ = false;
+  decls_[before].Successors.push_back(after);
+}
+
+bool TaskGraph::compile() {
+  std::lock_guard l(m_graph_);
+  if (is_compiled_) {
+    return true;
+  }
+
+  if (remaining_nodes_ > 0) {
+    // TODO (sessamekesh): Invoke error callback for "cannot compile while
+    // running"
+    return false;
+  }
+
+  // Kahn's algorithm - topological order doubles as the execution layout
+  size_t num_nodes = decls_.size();
+  std::vector<uint32_t> in_degree(num_nodes, 0);
+  for (const auto& decl : decls_) {
+    for (NodeId successor : decl.Successors) {
+      in_degree[successor]++;
+    }
+  }
+
+  std::vector<uint32_t> order;
+  order.reserve(num_nodes);
+  for (uint32_t i = 0; i < num_nodes; i++) {
+    if (in_degree[i] == 0) order.push_back(i);
+  }
+
+  std::vector<uint32_t> remaining_in_degree = in_degree;
+  for (size_t i = 0; i < order.size(); i++) {
+    for (NodeId successor : decls_[order[i]].Successors) {
+      if (--remaining_in_degree[successor] == 0) {
+        order.push_back(successor);
+      }
+    }
+  }
+
+  if (order.size() != num_nodes) {
+    return false;
+  }
+
+  std::vector<uint32_t> decl_to_compiled(num_nodes);
+  for (uint32_t i = 0; i < num_nodes; i++) {
+    decl_to_compiled[order[i]] = i;
+  }
+
+  nodes_.clear();
+  successors_.clear();
+  roots_.clear();
+  nodes_.reserve(num_nodes);
+  for (uint32_t i = 0; i < num_nodes; i++) {
+    NodeDecl& decl = decls_[order[i]];
+    CompiledNode node{};
+    node.Fn = &decl.Fn;
+    node.DependencyCount = in_degree[order[i]];
+    node.SuccessorsBegin = static_cast<uint32_t>(successors_.size());
+    for (NodeId successor : decl.Successors) {
+      successors_.push_back(decl_to_compiled[successor]);
+    }
+    node.SuccessorsEnd = static_cast<uint32_t>(successors_.size());
+    nodes_.push_back(node);
+
+    if (node.DependencyCount == 0) {
+      roots_.push_back(i);
+    }
+  }
+
+  pending_dependencies_ =
+      std::make_unique<std::atomic_uint32_t[]>(num_nodes);
+  is_compiled_ = true;
+  return true;
+}
+
+std::shared_ptr<Promise<void>> TaskGraph::execute(
+    std::shared_ptr<ExecutionContext> execution_context) {
+  if (!compile()) {
+    return nullptr;
+  }
+
+  std::lock_guard l(m_graph_);
+  if (nodes_.empty()) {
+    return Promise<void>::Immediate();
+  }
+
+  size_t expected = 0;
+  if (!remaining_nodes_.compare_exchange_strong(expected, nodes_.size())) {
+    // TODO (sessamekesh): Invoke error callback for "graph already running"
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    pending_dependencies_[i].store(nodes_[i].DependencyCount,
+                                   std::memory_order_relaxed);
+  }
+
+  auto done = Promise<void>::Create();
+  auto self = shared_from_this();
+  for (uint32_t root : roots_) {
+    execution_context->schedule(
+        Task::Of([self, root, execution_context, done]() {
+          self->run_from(root, execution_context, done);
+        }));
+  }
+
+  return done;
+}
+
+bool TaskGraph::is_running() const { return remaining_nodes_.load() > 0; }
+
+size_t TaskGraph::node_count() const {
+  std::lock_guard l(m_graph_);
+  return decls_.size();
+}
+
+void TaskGraph::run_from(
+    uint32_t node_idx,
+    const std::shared_ptr<ExecutionContext>& execution_context,
+    const std::shared_ptr<Promise<void>>& done) {
+  // Keep going with the first successor this node readies, instead of paying
+  // for a round trip through the execution context
+  constexpr uint32_t kNone = UINT32_MAX;
+  while (node_idx != kNone) {
+    const CompiledNode& node = nodes_[node_idx];
+    (*node.Fn)();
+
+    uint32_t next_idx = kNone;
+    for (uint32_t i = node.SuccessorsBegin; i < node.SuccessorsEnd; i++) {
+      uint32_t successor = successors_[i];
+      if (pending_dependencies_[successor].fetch_sub(
+              1, std::memory_order_acq_rel) != 1) {
+        continue;
+      }
+
+      if (next_idx == kNone) {
+        next_idx = successor;
+      } else {
+        execution_context->schedule(Task::Of(
+            [self = shared_from_this(), successor, execution_context, done]() {
+              self->run_from(successor, execution_context, done);
+            }));
+      }
+    }
+
+    if (remaining_nodes_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      done->resolve();
+    }
+
+    node_idx = next_idx;
+  }
+}
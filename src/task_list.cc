@@ -1,9 +1,39 @@
+#include <igasync/instrumentation.h>
 #include <igasync/task_list.h>
+#include <igasync/task_watchdog.h>
+#include <igasync/usdt.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
 
 using namespace igasync;
 
-TaskList::TaskList(TaskList::Desc desc) : tasks_(desc.QueueSizeHint) {
+TaskList::TaskList(TaskList::Desc desc)
+    : name_(desc.Name),
+      trace_id_(TraceRecorder::Get().register_task_list(desc.Name)),
+      tasks_(desc.QueueSizeHint),
+      counters_(desc.CollectMetrics ? std::make_unique<Counters>() : nullptr),
+      readiness_fd_(-1),
+      is_readiness_signaled_(false) {
   enqueue_listeners_.reserve(desc.EnqueueListenerSizeHint);
+
+#if defined(__linux__)
+  if (desc.UseReadinessFd) {
+    readiness_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  }
+#endif
+}
+
+TaskList::~TaskList() {
+  TraceRecorder::Get().unregister_task_list(trace_id_);
+
+#if defined(__linux__)
+  if (readiness_fd_ >= 0) {
+    ::close(readiness_fd_);
+  }
+#endif
 }
 
 std::shared_ptr<TaskList> TaskList::Create(TaskList::Desc desc) {
@@ -12,23 +42,96 @@ std::shared_ptr<TaskList> TaskList::Create(TaskList::Desc desc) {
 
 void TaskList::schedule(std::unique_ptr<Task> task) {
   task->mark_scheduled();
+  IGASYNC_INSTRUMENT(task_scheduled, *task, *this);
+  IGASYNC_PROBE3(task_list__schedule, task.get(), this, name_.c_str());
+
+  // Counted before enqueueing so that Dequeued never overtakes Enqueued
+  if (counters_) {
+    counters_->Enqueued.fetch_add(1, std::memory_order_relaxed);
+  }
   tasks_.enqueue(std::move(task));
 
+  if (readiness_fd_ >= 0) {
+    signal_readiness();
+  }
+
   std::shared_lock l(m_enqueue_listeners_);
   for (auto& listener : enqueue_listeners_) {
     listener->on_task_added();
   }
 }
 
+void TaskList::schedule_bulk(std::vector<std::unique_ptr<Task>> tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+
+  for (auto& task : tasks) {
+    task->mark_scheduled();
+    IGASYNC_INSTRUMENT(task_scheduled, *task, *this);
+    IGASYNC_PROBE3(task_list__schedule, task.get(), this, name_.c_str());
+  }
+
+  size_t count = tasks.size();
+  if (counters_) {
+    counters_->Enqueued.fetch_add(count, std::memory_order_relaxed);
+  }
+  tasks_.enqueue_bulk(std::make_move_iterator(tasks.begin()), count);
+
+  if (readiness_fd_ >= 0) {
+    signal_readiness();
+  }
+
+  std::shared_lock l(m_enqueue_listeners_);
+  for (auto& listener : enqueue_listeners_) {
+    listener->on_tasks_added(count);
+  }
+}
+
 bool TaskList::execute_next() {
   std::unique_ptr<Task> task = nullptr;
   if (tasks_.try_dequeue(task)) {
-    task->run();
+    if (counters_) {
+      auto started = std::chrono::high_resolution_clock::now();
+      counters_->Dequeued.fetch_add(1, std::memory_order_relaxed);
+      counters_->ScheduleToStart.record(started - task->scheduled_at());
+      run_task(*task);
+      counters_->RunTime.record(std::chrono::high_resolution_clock::now() -
+                                started);
+    } else {
+      run_task(*task);
+    }
     return true;
   }
+
+  if (readiness_fd_ >= 0) {
+    reset_readiness();
+  }
   return false;
 }
 
+void TaskList::run_task(Task& task) {
+  IGASYNC_PROBE2(task__start, &task, this);
+  bool is_watched = TaskWatchdog::is_watching();
+  TaskWatchdog::TaskState outer_task;
+  if (is_watched) {
+    outer_task = TaskWatchdog::begin_task(task.label(), trace_id_);
+  }
+
+  if (TraceRecorder::is_recording()) {
+    uint32_t outer_list = TraceRecorder::set_current_task_list(trace_id_);
+    task.run();
+    TraceRecorder::set_current_task_list(outer_list);
+  } else {
+    task.run();
+  }
+
+  if (is_watched) {
+    TaskWatchdog::end_task(outer_task);
+  }
+  IGASYNC_PROBE2(task__end, &task, this);
+}
+
 void TaskList::register_listener(
     std::shared_ptr<ITaskScheduledListener> listener) {
   std::unique_lock l(m_enqueue_listeners_);
@@ -42,3 +145,50 @@ void TaskList::unregister_listener(
                                        enqueue_listeners_.end(), listener),
                            enqueue_listeners_.end());
 }
+
+const std::string& TaskList::name() const { return name_; }
+
+int TaskList::readiness_fd() const { return readiness_fd_; }
+
+void TaskList::signal_readiness() {
+  // Release pairs with the acquire in reset_readiness, so that a consumer
+  // that clears the flag also sees the task enqueued before it was set
+  if (is_readiness_signaled_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+#if defined(__linux__)
+  uint64_t one = 1;
+  (void)::write(readiness_fd_, &one, sizeof(one));
+#endif
+}
+
+void TaskList::reset_readiness() {
+  // Drained even if the flag is already clear - a producer that set the flag
+  // may write to the eventfd only after an earlier reset cleared it, and that
+  // late signal would otherwise leave the fd readable over an empty list.
+  // Read before clearing the flag, so a producer that signals after the clear
+  // is never swallowed by this read.
+#if defined(__linux__)
+  uint64_t value;
+  (void)::read(readiness_fd_, &value, sizeof(value));
+#endif
+  is_readiness_signaled_.exchange(false, std::memory_order_acq_rel);
+
+  // A task enqueued before the flag was cleared did not signal - do it here
+  if (tasks_.size_approx() > 0) {
+    signal_readiness();
+  }
+}
+
+TaskListMetrics TaskList::metrics() const {
+  TaskListMetrics m;
+  m.QueueDepth = tasks_.size_approx();
+  if (counters_) {
+    m.Enqueued = counters_->Enqueued.load(std::memory_order_relaxed);
+    m.Dequeued = counters_->Dequeued.load(std::memory_order_relaxed);
+    m.ScheduleToStart = counters_->ScheduleToStart.snapshot();
+    m.RunTime = counters_->RunTime.snapshot();
+  }
+  return m;
+}
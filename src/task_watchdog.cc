@@ -0,0 +1,218 @@
+#include <igasync/task_watchdog.h>
+#include <igasync/trace_recorder.h>
+
+#include <unordered_map>
+
+using namespace igasync;
+
+// Written only by the owning thread, read by watchdog threads. Seqlocked so
+// that the watchdog never reports a half-written task.
+struct alignas(64) TaskWatchdog::Slot {
+  std::atomic_uint64_t Seq{0};
+  std::atomic_uint64_t Serial{0};
+  std::atomic_int64_t StartedNs{0};
+  std::atomic<const char*> Name{nullptr};
+  std::atomic<const char*> File{""};
+  std::atomic_uint32_t Line{0};
+  std::atomic_uint32_t TaskListId{0};
+
+  // Only touched by the owning thread. Serials are never reused, so a nested
+  // task returning to its outer task does not hand out a reported serial.
+  uint64_t LastSerial{0};
+
+  // Guarded by the slot registry mutex
+  bool InUse{false};
+  std::thread::id ThreadId{};
+};
+
+namespace {
+struct SlotRegistry {
+  std::mutex Mutex;
+  std::vector<std::unique_ptr<TaskWatchdog::Slot>> Slots;
+};
+
+SlotRegistry& slot_registry() {
+  static SlotRegistry registry;
+  return registry;
+}
+
+int64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+std::atomic_int TaskWatchdog::watchdog_count_ = 0;
+
+TaskWatchdog::Slot& TaskWatchdog::this_thread_slot() {
+  // Hands the slot back for reuse when the thread exits
+  struct SlotLease {
+    Slot* S{nullptr};
+    ~SlotLease() {
+      if (S != nullptr) {
+        S->StartedNs.store(0, std::memory_order_relaxed);
+        std::lock_guard l(slot_registry().Mutex);
+        S->InUse = false;
+      }
+    }
+  };
+  thread_local SlotLease lease;
+
+  if (lease.S == nullptr) {
+    auto& registry = slot_registry();
+    std::lock_guard l(registry.Mutex);
+    for (auto& slot : registry.Slots) {
+      if (!slot->InUse) {
+        lease.S = slot.get();
+        break;
+      }
+    }
+    if (lease.S == nullptr) {
+      registry.Slots.push_back(std::make_unique<Slot>());
+      lease.S = registry.Slots.back().get();
+    }
+    lease.S->InUse = true;
+    lease.S->ThreadId = std::this_thread::get_id();
+  }
+
+  return *lease.S;
+}
+
+namespace {
+void write_slot(TaskWatchdog::Slot& slot,
+                const TaskWatchdog::TaskState& state) {
+  uint64_t seq = slot.Seq.load(std::memory_order_relaxed);
+  slot.Seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.StartedNs.store(state.StartedNs, std::memory_order_relaxed);
+  slot.Name.store(state.Name, std::memory_order_relaxed);
+  slot.File.store(state.File, std::memory_order_relaxed);
+  slot.Line.store(state.Line, std::memory_order_relaxed);
+  slot.TaskListId.store(state.TaskListId, std::memory_order_relaxed);
+  slot.Serial.store(state.Serial, std::memory_order_relaxed);
+
+  slot.Seq.store(seq + 2, std::memory_order_release);
+}
+}  // namespace
+
+TaskWatchdog::TaskState TaskWatchdog::begin_task(const TaskLabel& label,
+                                                 uint32_t task_list_id) {
+  Slot& slot = this_thread_slot();
+
+  TaskState outer;
+  outer.StartedNs = slot.StartedNs.load(std::memory_order_relaxed);
+  outer.Name = slot.Name.load(std::memory_order_relaxed);
+  outer.File = slot.File.load(std::memory_order_relaxed);
+  outer.Line = slot.Line.load(std::memory_order_relaxed);
+  outer.TaskListId = slot.TaskListId.load(std::memory_order_relaxed);
+  outer.Serial = slot.Serial.load(std::memory_order_relaxed);
+
+  TaskState state;
+  state.StartedNs = steady_now_ns();
+  state.Name = label.Name;
+  state.File = label.Location.file_name();
+  state.Line = label.Location.line();
+  state.TaskListId = task_list_id;
+  state.Serial = ++slot.LastSerial;
+  ::write_slot(slot, state);
+
+  return outer;
+}
+
+void TaskWatchdog::end_task(const TaskState& outer) {
+  // The outer task keeps its own serial - it is only reported if it was not
+  // already, even when the nested task was
+  ::write_slot(this_thread_slot(), outer);
+}
+
+std::shared_ptr<TaskWatchdog> TaskWatchdog::Create(TaskWatchdog::Desc desc) {
+  return std::shared_ptr<TaskWatchdog>(new TaskWatchdog(desc));
+}
+
+TaskWatchdog::TaskWatchdog(TaskWatchdog::Desc desc)
+    : desc_(desc), is_stopping_(false) {
+  watchdog_count_++;
+  thread_ = std::thread([this]() { watch(); });
+}
+
+TaskWatchdog::~TaskWatchdog() {
+  {
+    std::lock_guard l(m_stop_);
+    is_stopping_ = true;
+  }
+  cv_stop_.notify_all();
+  thread_.join();
+  watchdog_count_--;
+}
+
+std::vector<StalledTask> TaskWatchdog::stalls() const {
+  std::lock_guard l(m_stalls_);
+  return stalls_;
+}
+
+void TaskWatchdog::watch() {
+  // Serial of the last task reported per slot, so each stall is reported once
+  std::unordered_map<const Slot*, uint64_t> reported_serials;
+
+  while (true) {
+    {
+      std::unique_lock l(m_stop_);
+      if (cv_stop_.wait_for(l, desc_.PollInterval,
+                            [this]() { return is_stopping_; })) {
+        return;
+      }
+    }
+
+    int64_t now = ::steady_now_ns();
+    std::vector<std::pair<StalledTask, uint32_t>> found;
+
+    {
+      auto& registry = slot_registry();
+      std::lock_guard l(registry.Mutex);
+      for (const auto& slot : registry.Slots) {
+        if (!slot->InUse) continue;
+
+        uint64_t seq_before = slot->Seq.load(std::memory_order_acquire);
+        if (seq_before % 2 != 0) continue;
+
+        int64_t started = slot->StartedNs.load(std::memory_order_relaxed);
+        uint64_t serial = slot->Serial.load(std::memory_order_relaxed);
+        StalledTask stall;
+        stall.ThreadId = slot->ThreadId;
+        stall.Name = slot->Name.load(std::memory_order_relaxed);
+        stall.File = slot->File.load(std::memory_order_relaxed);
+        stall.Line = slot->Line.load(std::memory_order_relaxed);
+        uint32_t task_list_id =
+            slot->TaskListId.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->Seq.load(std::memory_order_relaxed) != seq_before) continue;
+
+        if (started == 0 || now - started < desc_.Threshold.count()) continue;
+
+        auto it = reported_serials.find(slot.get());
+        if (it != reported_serials.end() && it->second == serial) continue;
+        reported_serials[slot.get()] = serial;
+
+        stall.RunningFor = std::chrono::nanoseconds(now - started);
+        found.push_back({stall, task_list_id});
+      }
+    }
+
+    for (auto& [stall, task_list_id] : found) {
+      stall.TaskListName = TraceRecorder::Get().task_list_name(task_list_id);
+
+      if (desc_.OnStall) {
+        desc_.OnStall(stall);
+      }
+
+      std::lock_guard l(m_stalls_);
+      stalls_.push_back(stall);
+      if (stalls_.size() > desc_.HistorySize) {
+        stalls_.erase(stalls_.begin());
+      }
+    }
+  }
+}
@@ -1,4 +1,6 @@
+#include <igasync/instrumentation.h>
 #include <igasync/thread_pool.h>
+#include <igasync/usdt.h>
 
 using namespace igasync;
 
@@ -18,8 +20,14 @@ ThreadPool::ThreadPool(ThreadPool::Desc desc)
     return;
   }
 
+  worker_counters_ = std::make_unique<WorkerCounters[]>(num_threads);
+
   for (size_t i = 0; i < num_threads; i++) {
-    threads_.push_back(std::thread([this, t = this]() {
+    threads_.push_back(std::thread([this, t = this, i]() {
+      TraceRecorder::Get().set_thread_name("igasync worker " +
+                                           std::to_string(i));
+      WorkerCounters& counters = t->worker_counters_[i];
+      auto phase_start = std::chrono::high_resolution_clock::now();
       while (!t->is_cancelled_) {
         // Execute tasks from the task provider until there are no more tasks to
         // execute...
@@ -31,6 +39,7 @@ ThreadPool::ThreadPool(ThreadPool::Desc desc)
                 (int)((i + t->next_task_list_idx_) % t->task_lists_.size());
             if (t->task_lists_[i]->execute_next()) {
               t->next_task_list_idx_ = (i + 1ll) % t->task_lists_.size();
+              counters.TasksExecuted.fetch_add(1, std::memory_order_relaxed);
               task_executed = true;
               break;
             }
@@ -43,26 +52,74 @@ ThreadPool::ThreadPool(ThreadPool::Desc desc)
           }
         }
 
+        auto busy_end = std::chrono::high_resolution_clock::now();
+        counters.BusyNs.fetch_add((busy_end - phase_start).count(),
+                                  std::memory_order_relaxed);
+        phase_start = busy_end;
+
         // This thread can rest, since all task lists are empty
         std::unique_lock l(t->m_has_task_);
-        t->cv_has_task_.wait(l, [t]() {
+        uint64_t parks_seen = counters.Parks.load(std::memory_order_relaxed);
+        int64_t predicate_busy_ns = 0;
+        t->cv_has_task_.wait(l, [t, &counters, &parks_seen,
+                                 &predicate_busy_ns]() {
+          // Any evaluation after this worker parked means it was woken up
+          uint64_t parks = counters.Parks.load(std::memory_order_relaxed);
+          if (parks != parks_seen) {
+            parks_seen = parks;
+            IGASYNC_INSTRUMENT(worker_unparked,
+                               &counters - t->worker_counters_.get());
+            IGASYNC_PROBE2(worker__unpark, t,
+                           &counters - t->worker_counters_.get());
+          }
+
           // Predicate is not matched if task provider is empty, leave and wait
-          std::shared_lock l(t->m_task_lists_);
+          auto scan_start = std::chrono::high_resolution_clock::now();
+          bool task_executed = false;
+          {
+            std::shared_lock l(t->m_task_lists_);
+            for (int i = 0; i < t->task_lists_.size(); i++) {
+              int idx =
+                  (int)((i + t->next_task_list_idx_) % t->task_lists_.size());
+              if (t->task_lists_[idx]->execute_next()) {
+                t->next_task_list_idx_ = (idx + 1ll) % t->task_lists_.size();
+                counters.TasksExecuted.fetch_add(1,
+                                                 std::memory_order_relaxed);
+                task_executed = true;
+                break;
+              }
+            }
+          }
+
+          // The first task after a wakeup runs here - it counts as busy time,
+          // not as part of the wait
+          predicate_busy_ns +=
+              (std::chrono::high_resolution_clock::now() - scan_start).count();
 
           // If the task provider successfully executed a task, stop blocking!
-          for (int i = 0; i < t->task_lists_.size(); i++) {
-            int idx =
-                (int)((i + t->next_task_list_idx_) % t->task_lists_.size());
-            if (t->task_lists_[idx]->execute_next()) {
-              t->next_task_list_idx_ = (idx + 1ll) % t->task_lists_.size();
-              return true;
-            }
+          if (task_executed) {
+            return true;
           }
 
           // No task was executed, but still continue if this thread is
           // shutting down
-          return t->is_cancelled_.load();
+          if (t->is_cancelled_.load()) {
+            return true;
+          }
+          counters.Parks.fetch_add(1, std::memory_order_relaxed);
+          IGASYNC_INSTRUMENT(worker_parked,
+                             &counters - t->worker_counters_.get());
+          IGASYNC_PROBE2(worker__park, t,
+                         &counters - t->worker_counters_.get());
+          return false;
         });
+
+        auto idle_end = std::chrono::high_resolution_clock::now();
+        counters.BusyNs.fetch_add(predicate_busy_ns, std::memory_order_relaxed);
+        counters.IdleNs.fetch_add(
+            (idle_end - phase_start).count() - predicate_busy_ns,
+            std::memory_order_relaxed);
+        phase_start = idle_end;
       }
     }));
   }
@@ -117,4 +174,39 @@ std::vector<std::thread::id> ThreadPool::thread_ids() const {
   return ids;
 }
 
+ThreadPoolMetrics ThreadPool::metrics() const {
+  ThreadPoolMetrics m;
+  m.Workers.reserve(threads_.size());
+
+  for (size_t i = 0; i < threads_.size(); i++) {
+    const WorkerCounters& counters = worker_counters_[i];
+
+    WorkerMetrics worker;
+    worker.ThreadId = threads_[i].get_id();
+    worker.TasksExecuted =
+        counters.TasksExecuted.load(std::memory_order_relaxed);
+    worker.Parks = counters.Parks.load(std::memory_order_relaxed);
+    worker.BusyTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::duration(
+            counters.BusyNs.load(std::memory_order_relaxed)));
+    worker.IdleTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::duration(
+            counters.IdleNs.load(std::memory_order_relaxed)));
+    m.Workers.push_back(worker);
+  }
+
+  return m;
+}
+
 void ThreadPool::on_task_added() { cv_has_task_.notify_one(); }
+
+void ThreadPool::on_tasks_added(size_t count) {
+  if (count >= threads_.size()) {
+    cv_has_task_.notify_all();
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    cv_has_task_.notify_one();
+  }
+}
@@ -0,0 +1,331 @@
+#include <igasync/timer_wheel.h>
+#include <igasync/trace_recorder.h>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+using namespace igasync;
+
+namespace {
+const uint64_t kNoWakeTick = std::numeric_limits<uint64_t>::max();
+
+// Longest single sleep of the timer thread - keeps far off wakeup times from
+// overflowing the condition variable's clock conversion
+const auto kMaxSleep = std::chrono::hours(1);
+}  // namespace
+
+std::shared_ptr<TimerWheel> TimerWheel::Create(TimerWheel::Desc desc) {
+  return std::shared_ptr<TimerWheel>(new TimerWheel(std::move(desc)));
+}
+
+std::shared_ptr<TimerWheel> TimerWheel::Default() {
+  static auto wheel = TimerWheel::Create();
+  return wheel;
+}
+
+TimerWheel::TimerWheel(TimerWheel::Desc desc)
+    : desc_(std::move(desc)),
+      start_(Clock::now()),
+      now_tick_(0),
+      pending_count_(0),
+      wake_tick_(::kNoWakeTick),
+      is_stopping_(false) {
+  if (desc_.Resolution.count() <= 0) {
+    desc_.Resolution = std::chrono::nanoseconds(1);
+  }
+
+  timers_.reserve(desc_.CapacityHint);
+  for (uint32_t level = 0; level < kLevels; level++) {
+    occupied_slots_[level] = 0;
+    for (uint32_t slot = 0; slot < kSlotsPerLevel; slot++) {
+      slot_heads_[level][slot] = kNil;
+    }
+  }
+
+  if (desc_.UseDedicatedThread) {
+    timer_thread_ = std::thread([this]() { run_thread(); });
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  {
+    std::lock_guard l(m_wheel_);
+    is_stopping_ = true;
+  }
+  cv_wake_.notify_all();
+
+  if (timer_thread_.joinable()) {
+    timer_thread_.join();
+  }
+}
+
+TimerWheel::TimerId TimerWheel::schedule_after(
+    Clock::duration delay, std::unique_ptr<Task> task,
+    std::shared_ptr<ExecutionContext> execution_context) {
+  return schedule_at(Clock::now() + delay, std::move(task),
+                     std::move(execution_context));
+}
+
+TimerWheel::TimerId TimerWheel::schedule_at(
+    Clock::time_point time, std::unique_ptr<Task> task,
+    std::shared_ptr<ExecutionContext> execution_context) {
+  uint64_t tick = tick_at(time, true);
+
+  std::unique_lock l(m_wheel_);
+  uint32_t idx;
+  if (free_timers_.empty()) {
+    idx = static_cast<uint32_t>(timers_.size());
+    timers_.emplace_back();
+  } else {
+    idx = free_timers_.back();
+    free_timers_.pop_back();
+  }
+
+  Timer& timer = timers_[idx];
+  // Already due - fires on the next advance
+  timer.Tick = std::max(tick, now_tick_);
+  timer.Fire = std::move(task);
+  timer.Context = std::move(execution_context);
+  link(idx);
+  pending_count_++;
+
+  TimerId id = (static_cast<uint64_t>(timer.Generation) << 32) | idx;
+
+  // Only wake the timer thread if it is sleeping past this timer, so that
+  // adding many timers does not signal it for each one
+  bool should_wake = timer.Tick < wake_tick_;
+  if (should_wake) {
+    wake_tick_ = timer.Tick;
+  }
+  l.unlock();
+
+  if (should_wake) {
+    cv_wake_.notify_one();
+  }
+  return id;
+}
+
+std::shared_ptr<Promise<void>> TimerWheel::delay(
+    Clock::duration delay,
+    std::shared_ptr<ExecutionContext> execution_context) {
+  auto rsl = Promise<void>::Create();
+  schedule_after(delay, Task::Of([rsl]() { rsl->resolve(); }),
+                 std::move(execution_context));
+  return rsl;
+}
+
+bool TimerWheel::cancel(TimerWheel::TimerId timer) {
+  uint32_t idx = static_cast<uint32_t>(timer & 0xFFFFFFFF);
+  uint32_t generation = static_cast<uint32_t>(timer >> 32);
+
+  // Destroyed after the lock is released
+  std::unique_ptr<Task> task;
+  std::shared_ptr<ExecutionContext> execution_context;
+  {
+    std::lock_guard l(m_wheel_);
+    if (idx >= timers_.size()) {
+      return false;
+    }
+
+    Timer& t = timers_[idx];
+    if (!t.IsPending || t.Generation != generation) {
+      return false;
+    }
+
+    unlink(idx);
+    task = std::move(t.Fire);
+    execution_context = std::move(t.Context);
+    release(idx);
+  }
+  return true;
+}
+
+size_t TimerWheel::advance(Clock::time_point now) {
+  std::vector<ContextTask> due;
+  {
+    std::lock_guard l(m_wheel_);
+    // Timers scheduled in the past sit at now_tick_, and are due regardless
+    uint64_t target_tick = std::max(tick_at(now, false), now_tick_);
+    while (true) {
+      auto next = next_slot();
+      if (!next || next->Tick > target_tick) {
+        break;
+      }
+
+      now_tick_ = next->Tick;
+      uint32_t idx = slot_heads_[next->Level][next->Slot];
+      slot_heads_[next->Level][next->Slot] = kNil;
+      occupied_slots_[next->Level] &= ~(1ull << next->Slot);
+
+      while (idx != kNil) {
+        Timer& timer = timers_[idx];
+        uint32_t next_idx = timer.Next;
+
+        if (next->Level == 0) {
+          due.push_back({std::move(timer.Context), std::move(timer.Fire)});
+          release(idx);
+        } else {
+          // Cascade - the rest of the timer's wait falls in a finer level
+          link(idx);
+        }
+
+        idx = next_idx;
+      }
+    }
+
+    now_tick_ = std::max(now_tick_, target_tick);
+  }
+
+  size_t fired = due.size();
+  schedule_grouped(std::move(due));
+  return fired;
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::next_wakeup() const {
+  std::lock_guard l(m_wheel_);
+  auto next = next_slot();
+  if (!next) {
+    return std::nullopt;
+  }
+  return time_at(next->Tick);
+}
+
+size_t TimerWheel::pending_count() const {
+  std::lock_guard l(m_wheel_);
+  return pending_count_;
+}
+
+uint64_t TimerWheel::tick_at(Clock::time_point time, bool round_up) const {
+  if (time <= start_) {
+    return 0;
+  }
+
+  uint64_t ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time - start_)
+          .count());
+  uint64_t resolution = static_cast<uint64_t>(desc_.Resolution.count());
+  return round_up ? (ns / resolution) + (ns % resolution != 0)
+                  : ns / resolution;
+}
+
+TimerWheel::Clock::time_point TimerWheel::time_at(uint64_t tick) const {
+  uint64_t resolution = static_cast<uint64_t>(desc_.Resolution.count());
+  uint64_t max_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::time_point::max() - start_)
+                        .count();
+  if (tick > max_ns / resolution) {
+    return Clock::time_point::max();
+  }
+
+  return start_ + std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::nanoseconds(tick * resolution));
+}
+
+void TimerWheel::link(uint32_t idx) {
+  Timer& timer = timers_[idx];
+
+  // Highest bit that differs from the current tick picks the level, so every
+  // timer on a level is due before the level wraps around
+  uint64_t masked = timer.Tick ^ now_tick_;
+  uint32_t level =
+      masked < kSlotsPerLevel
+          ? 0
+          : (static_cast<uint32_t>(std::bit_width(masked)) - 1) / kSlotBits;
+  uint32_t slot = (timer.Tick >> (level * kSlotBits)) & (kSlotsPerLevel - 1);
+
+  timer.Level = static_cast<uint8_t>(level);
+  timer.Slot = static_cast<uint8_t>(slot);
+  timer.Prev = kNil;
+  timer.Next = slot_heads_[level][slot];
+  if (timer.Next != kNil) {
+    timers_[timer.Next].Prev = idx;
+  }
+  slot_heads_[level][slot] = idx;
+  occupied_slots_[level] |= 1ull << slot;
+  timer.IsPending = true;
+}
+
+void TimerWheel::unlink(uint32_t idx) {
+  Timer& timer = timers_[idx];
+
+  if (timer.Prev != kNil) {
+    timers_[timer.Prev].Next = timer.Next;
+  } else {
+    slot_heads_[timer.Level][timer.Slot] = timer.Next;
+  }
+  if (timer.Next != kNil) {
+    timers_[timer.Next].Prev = timer.Prev;
+  }
+
+  if (slot_heads_[timer.Level][timer.Slot] == kNil) {
+    occupied_slots_[timer.Level] &= ~(1ull << timer.Slot);
+  }
+  timer.Prev = timer.Next = kNil;
+}
+
+void TimerWheel::release(uint32_t idx) {
+  Timer& timer = timers_[idx];
+  timer.IsPending = false;
+  timer.Prev = timer.Next = kNil;
+  timer.Generation++;
+  if (timer.Generation == 0) {
+    timer.Generation = 1;
+  }
+
+  free_timers_.push_back(idx);
+  pending_count_--;
+}
+
+std::optional<TimerWheel::SlotRef> TimerWheel::next_slot() const {
+  // Every timer on a finer level is due before any timer on a coarser one
+  for (uint32_t level = 0; level < kLevels; level++) {
+    if (occupied_slots_[level] == 0) {
+      continue;
+    }
+
+    uint32_t shift = level * kSlotBits;
+    uint32_t now_slot = (now_tick_ >> shift) & (kSlotsPerLevel - 1);
+    uint64_t ahead = occupied_slots_[level] & (~0ull << now_slot);
+    uint32_t slot = static_cast<uint32_t>(
+        std::countr_zero(ahead != 0 ? ahead : occupied_slots_[level]));
+
+    uint32_t level_bits = shift + kSlotBits;
+    uint64_t level_start =
+        level_bits >= 64 ? 0 : now_tick_ & ~((1ull << level_bits) - 1);
+    return SlotRef{level_start + (static_cast<uint64_t>(slot) << shift), level,
+                   slot};
+  }
+  return std::nullopt;
+}
+
+void TimerWheel::run_thread() {
+  TraceRecorder::Get().set_thread_name(desc_.Name);
+
+  std::unique_lock l(m_wheel_);
+  while (!is_stopping_) {
+    auto next = next_slot();
+    auto now = Clock::now();
+    if (next && next->Tick <= tick_at(now, false)) {
+      wake_tick_ = ::kNoWakeTick;
+      l.unlock();
+      advance(now);
+      l.lock();
+      continue;
+    }
+
+    if (!next) {
+      wake_tick_ = ::kNoWakeTick;
+      cv_wake_.wait_for(l, ::kMaxSleep);
+    } else {
+      wake_tick_ = next->Tick;
+      cv_wake_.wait_until(l, std::min(time_at(next->Tick), now + ::kMaxSleep));
+    }
+  }
+}
+
+std::shared_ptr<Promise<void>> igasync::delay(
+    TimerWheel::Clock::duration delay,
+    std::shared_ptr<ExecutionContext> execution_context) {
+  return TimerWheel::Default()->delay(delay, std::move(execution_context));
+}
@@ -0,0 +1,277 @@
+#include <igasync/trace_recorder.h>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace igasync;
+
+namespace {
+thread_local uint32_t tls_current_task_list = 0;
+thread_local uint64_t tls_current_task = 0;
+
+void write_json_string(std::ostream& out, const std::string& s) {
+  out << '"';
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << (int)c << std::dec << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+// Chrome trace timestamps are in microseconds
+double to_us(int64_t ns) { return (double)ns / 1000.; }
+}  // namespace
+
+std::atomic_bool TraceRecorder::is_recording_ = false;
+
+TraceRecorder& TraceRecorder::Get() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : next_task_id_(1),
+      next_task_list_id_(1),
+      generation_(0),
+      events_per_thread_(0),
+      epoch_(0) {}
+
+void TraceRecorder::start(size_t events_per_thread) {
+  if (events_per_thread == 0) {
+    events_per_thread = 1;
+  }
+
+  events_per_thread_ = events_per_thread;
+  epoch_ = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+  // Threads notice the new generation the next time they record, and reset
+  // their own buffers - start() never touches a buffer another thread owns
+  generation_++;
+  {
+    std::lock_guard l(m_tracks_);
+    retired_task_list_names_.clear();
+  }
+  is_recording_ = true;
+}
+
+void TraceRecorder::stop() { is_recording_ = false; }
+
+uint32_t TraceRecorder::set_current_task_list(uint32_t task_list_id) {
+  return std::exchange(tls_current_task_list, task_list_id);
+}
+
+uint64_t TraceRecorder::set_current_task(uint64_t task_id) {
+  return std::exchange(tls_current_task, task_id);
+}
+
+TraceRecorder::ThreadTrack& TraceRecorder::this_thread_track() {
+  thread_local std::shared_ptr<ThreadTrack> tls_track = nullptr;
+  if (tls_track == nullptr) {
+    auto track = std::make_shared<ThreadTrack>();
+    std::lock_guard l(m_tracks_);
+    track->ThreadIdx = static_cast<uint32_t>(tracks_.size() + 1);
+    track->Name = "Thread " + std::to_string(track->ThreadIdx);
+    tracks_.push_back(track);
+    tls_track = track;
+  }
+  return *tls_track;
+}
+
+void TraceRecorder::set_thread_name(std::string name) {
+  ThreadTrack& track = this_thread_track();
+  std::lock_guard l(m_tracks_);
+  track.Name = std::move(name);
+}
+
+uint32_t TraceRecorder::register_task_list(std::string name) {
+  uint32_t id = next_task_list_id_++;
+  std::lock_guard l(m_tracks_);
+  task_list_names_[id] = std::move(name);
+  return id;
+}
+
+void TraceRecorder::unregister_task_list(uint32_t task_list_id) {
+  std::lock_guard l(m_tracks_);
+  auto it = task_list_names_.find(task_list_id);
+  if (it == task_list_names_.end()) {
+    return;
+  }
+
+  if (is_recording()) {
+    retired_task_list_names_[task_list_id] = std::move(it->second);
+  }
+  task_list_names_.erase(it);
+}
+
+std::string TraceRecorder::task_list_name(uint32_t task_list_id) {
+  std::lock_guard l(m_tracks_);
+  const std::string* name = find_task_list_name(task_list_id);
+  return name == nullptr ? std::string() : *name;
+}
+
+const std::string* TraceRecorder::find_task_list_name(
+    uint32_t task_list_id) const {
+  auto it = task_list_names_.find(task_list_id);
+  if (it != task_list_names_.end()) {
+    return &it->second;
+  }
+
+  auto retired_it = retired_task_list_names_.find(task_list_id);
+  return retired_it == retired_task_list_names_.end() ? nullptr
+                                                      : &retired_it->second;
+}
+
+TaskTraceIds TraceRecorder::on_task_created() {
+  TaskTraceIds ids;
+  ids.TaskId = next_task_id_.fetch_add(1, std::memory_order_relaxed);
+  ids.ParentTaskId = tls_current_task;
+  ids.CreatorThread = this_thread_track().ThreadIdx;
+  return ids;
+}
+
+int64_t TraceRecorder::to_ns(
+    std::chrono::high_resolution_clock::time_point t) const {
+  std::chrono::high_resolution_clock::duration since_epoch(
+      t.time_since_epoch().count() - epoch_.load(std::memory_order_relaxed));
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch)
+      .count();
+}
+
+void TraceRecorder::record_task(
+    const TaskTraceIds& ids,
+    std::chrono::high_resolution_clock::time_point created,
+    std::chrono::high_resolution_clock::time_point scheduled,
+    std::chrono::high_resolution_clock::time_point started,
+    std::chrono::high_resolution_clock::time_point finished) {
+  ThreadTrack& track = this_thread_track();
+
+  uint64_t generation = generation_.load(std::memory_order_acquire);
+  if (track.Generation.load(std::memory_order_relaxed) != generation) {
+    size_t capacity = events_per_thread_.load(std::memory_order_relaxed);
+    if (track.Capacity != capacity) {
+      std::lock_guard l(m_tracks_);
+      track.Slots = std::make_unique<EventSlot[]>(capacity);
+      track.Capacity = capacity;
+    }
+    track.WriteIdx.store(0, std::memory_order_relaxed);
+    track.Generation.store(generation, std::memory_order_release);
+  }
+
+  uint64_t idx = track.WriteIdx.load(std::memory_order_relaxed);
+  EventSlot& slot = track.Slots[idx % track.Capacity];
+
+  uint64_t seq = slot.Seq.load(std::memory_order_relaxed);
+  slot.Seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.TaskId.store(ids.TaskId, std::memory_order_relaxed);
+  slot.ParentTaskId.store(ids.ParentTaskId, std::memory_order_relaxed);
+  slot.CreatorThread.store(ids.CreatorThread, std::memory_order_relaxed);
+  slot.TaskListId.store(tls_current_task_list, std::memory_order_relaxed);
+  slot.CreatedNs.store(to_ns(created), std::memory_order_relaxed);
+  slot.ScheduledNs.store(to_ns(scheduled), std::memory_order_relaxed);
+  slot.StartedNs.store(to_ns(started), std::memory_order_relaxed);
+  slot.FinishedNs.store(to_ns(finished), std::memory_order_relaxed);
+
+  slot.Seq.store(seq + 2, std::memory_order_release);
+  track.WriteIdx.store(idx + 1, std::memory_order_release);
+}
+
+void TraceRecorder::write_json(std::ostream& out) {
+  std::lock_guard l(m_tracks_);
+  uint64_t generation = generation_.load(std::memory_order_acquire);
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,"
+         "\"args\":{\"name\":\"igasync\"}}";
+
+  for (const auto& track : tracks_) {
+    out << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+        << track->ThreadIdx << ",\"args\":{\"name\":";
+    write_json_string(out, track->Name);
+    out << "}}";
+  }
+
+  out << std::fixed << std::setprecision(3);
+  for (const auto& track : tracks_) {
+    if (track->Generation.load(std::memory_order_acquire) != generation ||
+        track->Capacity == 0) {
+      continue;
+    }
+
+    uint64_t write_idx = track->WriteIdx.load(std::memory_order_acquire);
+    uint64_t begin_idx =
+        write_idx > track->Capacity ? write_idx - track->Capacity : 0;
+
+    for (uint64_t i = begin_idx; i < write_idx; i++) {
+      EventSlot& slot = track->Slots[i % track->Capacity];
+
+      uint64_t seq_before = slot.Seq.load(std::memory_order_acquire);
+      if (seq_before % 2 != 0) continue;
+
+      uint64_t task_id = slot.TaskId.load(std::memory_order_relaxed);
+      uint64_t parent_id = slot.ParentTaskId.load(std::memory_order_relaxed);
+      uint64_t creator = slot.CreatorThread.load(std::memory_order_relaxed);
+      uint32_t task_list_id =
+          (uint32_t)slot.TaskListId.load(std::memory_order_relaxed);
+      int64_t created = slot.CreatedNs.load(std::memory_order_relaxed);
+      int64_t scheduled = slot.ScheduledNs.load(std::memory_order_relaxed);
+      int64_t started = slot.StartedNs.load(std::memory_order_relaxed);
+      int64_t finished = slot.FinishedNs.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.Seq.load(std::memory_order_relaxed) != seq_before) continue;
+
+      // Task started before the current recording began
+      if (started < 0) continue;
+
+      const std::string* list_name = find_task_list_name(task_list_id);
+      std::string name = list_name == nullptr ? "Task" : *list_name;
+
+      out << ",\n{\"ph\":\"X\",\"cat\":\"igasync\",\"name\":";
+      write_json_string(out, name);
+      out << ",\"pid\":1,\"tid\":" << track->ThreadIdx
+          << ",\"ts\":" << to_us(started)
+          << ",\"dur\":" << to_us(finished - started)
+          << ",\"args\":{\"task_id\":" << task_id
+          << ",\"queue_wait_us\":" << to_us(started - scheduled) << "}}";
+
+      // Flow arrow from the slice that created this task to this task
+      if (parent_id != 0 && created >= 0) {
+        out << ",\n{\"ph\":\"s\",\"cat\":\"igasync\",\"name\":\"then\","
+               "\"pid\":1,\"tid\":"
+            << creator << ",\"ts\":" << to_us(created) << ",\"id\":" << task_id
+            << "}";
+        out << ",\n{\"ph\":\"f\",\"bp\":\"e\",\"cat\":\"igasync\","
+               "\"name\":\"then\",\"pid\":1,\"tid\":"
+            << track->ThreadIdx << ",\"ts\":" << to_us(started)
+            << ",\"id\":" << task_id << "}";
+      }
+    }
+  }
+
+  out << "\n]}\n";
+  out << std::defaultfloat;
+}
+
+std::string TraceRecorder::to_json() {
+  std::stringstream ss;
+  write_json(ss);
+  return ss.str();
+}
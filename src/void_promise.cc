@@ -2,16 +2,29 @@
 
 namespace igasync {
 
-std::shared_ptr<Promise<void>> Promise<void>::Create() {
-  return std::shared_ptr<Promise<void>>(new Promise<void>());
+std::shared_ptr<Promise<void>> Promise<void>::Create(
+    std::source_location location) {
+  auto p = std::shared_ptr<Promise<void>>(new Promise<void>());
+  IGASYNC_INSTRUMENT(promise_created, p.get());
+  if (PromiseCensus::is_enabled()) {
+    p->census_entry_ = PromiseCensus::Get().add(p.get(), location);
+  }
+  return p;
 }
 
-std::shared_ptr<Promise<void>> Promise<void>::Immediate() {
-  auto p = Create();
+std::shared_ptr<Promise<void>> Promise<void>::Immediate(
+    std::source_location location) {
+  auto p = Create(location);
   p->resolve();
   return p;
 }
 
+Promise<void>::~Promise() {
+  if (census_entry_ != nullptr) {
+    PromiseCensus::Get().remove(census_entry_);
+  }
+}
+
 std::shared_ptr<Promise<void>> Promise<void>::resolve() {
   std::scoped_lock l(m_then_queue_);
 
@@ -21,6 +34,16 @@ std::shared_ptr<Promise<void>> Promise<void>::resolve() {
   }
 
   is_finished_ = true;
+  if (census_entry_ != nullptr) {
+    census_entry_->IsResolved = true;
+    census_entry_->PendingContinuations = 0;
+    census_entry_->CapturedBytes = 0;
+  }
+  IGASYNC_INSTRUMENT(promise_resolved, this);
+  IGASYNC_PROBE1(promise__resolve, this);
+  if (DependencyRecorder::is_recording()) {
+    DependencyRecorder::Get().on_promise_resolved(this);
+  }
 
   {
     while (!then_queue_.empty()) {
@@ -29,7 +52,8 @@ std::shared_ptr<Promise<void>> Promise<void>::resolve() {
 
       // Optimization: do not need to hold on to Promise implementation, since
       // the invoked method does not require any access to the data itself!
-      v.Scheduler->schedule(Task::Of(std::move(v.Fn)));
+      v.Scheduler->schedule(
+          Task::Continuation(this, v.Label, std::move(v.Fn)));
     }
   }
 
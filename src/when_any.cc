@@ -0,0 +1,62 @@
+#include <igasync/when_any.h>
+
+using namespace igasync;
+
+RaceExecutionContext::RaceExecutionContext(
+    std::shared_ptr<std::atomic_size_t> winner, size_t index,
+    std::shared_ptr<ExecutionContext> inner_context)
+    : winner_(std::move(winner)),
+      index_(index),
+      inner_context_(std::move(inner_context)) {}
+
+void RaceExecutionContext::schedule(std::unique_ptr<Task> task) {
+  size_t expected = kNoWinner;
+  if (winner_->compare_exchange_strong(expected, index_)) {
+    inner_context_->schedule(std::move(task));
+    return;
+  }
+
+  // Lost the race - only promise bookkeeping remains, run it right here
+  task->run();
+}
+
+namespace igasync {
+
+std::shared_ptr<Promise<size_t>> when_any(
+    const std::vector<std::shared_ptr<Promise<void>>>& promises,
+    std::shared_ptr<ExecutionContext> execution_context,
+    std::function<void(size_t)> on_lost) {
+  auto rsl = Promise<size_t>::Create();
+  auto state = std::make_shared<WhenAnyState<size_t>>(
+      WhenAnyState<size_t>{rsl, std::move(on_lost)});
+  auto winner =
+      std::make_shared<std::atomic_size_t>(RaceExecutionContext::kNoWinner);
+  size_t num_promises = promises.size();
+
+  for (size_t i = 0; i < num_promises; i++) {
+    promises[i]->on_resolve(
+        [state, winner, i, num_promises]() {
+          if (winner->load() != i) {
+            return;
+          }
+
+          // Only the winner gets here, and only once
+          auto result = std::move(state->Result);
+          auto lost = std::move(state->OnLost);
+          if (lost) {
+            for (size_t j = 0; j < num_promises; j++) {
+              if (j != i) {
+                lost(j);
+              }
+            }
+          }
+
+          result->resolve(i);
+        },
+        std::make_shared<RaceExecutionContext>(winner, i, execution_context));
+  }
+
+  return rsl;
+}
+
+}  // namespace igasync
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <igasync/blocking_pool.h>
+#include <igasync/task_list.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace igasync;
+
+namespace {
+// Holds blocking calls until released, tracking how many wait at once
+class Gate {
+ public:
+  void wait() {
+    std::unique_lock l(m_);
+    waiting_++;
+    peak_waiting_ = std::max(peak_waiting_, waiting_);
+    cv_.notify_all();
+    cv_.wait(l, [this]() { return is_open_; });
+    waiting_--;
+  }
+
+  void wait_for_waiters(int count) {
+    std::unique_lock l(m_);
+    cv_.wait(l, [this, count]() { return waiting_ >= count; });
+  }
+
+  void open() {
+    std::lock_guard l(m_);
+    is_open_ = true;
+    cv_.notify_all();
+  }
+
+  int peak_waiting() {
+    std::lock_guard l(m_);
+    return peak_waiting_;
+  }
+
+ private:
+  std::mutex m_;
+  std::condition_variable cv_;
+  int waiting_{0};
+  int peak_waiting_{0};
+  bool is_open_{false};
+};
+
+template <typename PredT>
+bool spin_until(PredT pred) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+TEST(BlockingPool, resolvesOnCompletionContext) {
+  auto pool = BlockingPool::Create();
+  auto tl = TaskList::Create();
+
+  std::thread::id blocking_thread_id;
+  auto rsl = pool->run(
+      [&blocking_thread_id]() {
+        blocking_thread_id = std::this_thread::get_id();
+        return 42;
+      },
+      tl);
+
+  // Nothing resolves until the completion context runs
+  ASSERT_TRUE(::spin_until([pool]() {
+    return pool->idle_thread_count() == pool->thread_count();
+  }));
+  EXPECT_FALSE(rsl->is_finished());
+
+  ASSERT_TRUE(::spin_until([tl, rsl]() {
+    tl->execute_next();
+    return rsl->is_finished();
+  }));
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 42);
+  EXPECT_NE(blocking_thread_id, std::this_thread::get_id());
+}
+
+TEST(BlockingPool, resolvesOnBlockingThreadWithoutContext) {
+  auto pool = BlockingPool::Create();
+
+  std::atomic_bool ran = false;
+  auto rsl = pool->run([&ran]() { ran = true; });
+
+  ASSERT_TRUE(::spin_until([rsl]() { return rsl->is_finished(); }));
+  EXPECT_TRUE(ran);
+}
+
+TEST(BlockingPool, startsThreadsOnDemandUpToMax) {
+  BlockingPool::Desc desc;
+  desc.MaxThreads = 3;
+  auto pool = BlockingPool::Create(desc);
+  EXPECT_EQ(pool->thread_count(), 0);
+
+  ::Gate gate;
+  std::atomic_int finished = 0;
+  for (int i = 0; i < 6; i++) {
+    pool->schedule(Task::Of([&gate, &finished]() {
+      gate.wait();
+      finished++;
+    }));
+  }
+
+  gate.wait_for_waiters(3);
+  EXPECT_EQ(pool->thread_count(), 3);
+  EXPECT_EQ(pool->queued_task_count(), 3);
+
+  gate.open();
+  ASSERT_TRUE(::spin_until([&finished]() { return finished == 6; }));
+  EXPECT_EQ(gate.peak_waiting(), 3);
+}
+
+TEST(BlockingPool, idleThreadsExitDownToMin) {
+  BlockingPool::Desc desc;
+  desc.MinThreads = 1;
+  desc.MaxThreads = 4;
+  desc.IdleTimeout = std::chrono::milliseconds(5);
+  auto pool = BlockingPool::Create(desc);
+  EXPECT_EQ(pool->thread_count(), 1);
+
+  ::Gate gate;
+  for (int i = 0; i < 4; i++) {
+    pool->schedule(Task::Of([&gate]() { gate.wait(); }));
+  }
+  gate.wait_for_waiters(4);
+  EXPECT_EQ(pool->thread_count(), 4);
+
+  gate.open();
+  ASSERT_TRUE(::spin_until([pool]() { return pool->thread_count() == 1; }));
+
+  // The remaining thread still picks up new work
+  auto rsl = pool->run([]() { return 5; });
+  ASSERT_TRUE(::spin_until([rsl]() { return rsl->is_finished(); }));
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 5);
+}
+
+TEST(BlockingPool, destructorRunsQueuedTasks) {
+  BlockingPool::Desc desc;
+  desc.MaxThreads = 1;
+  auto pool = BlockingPool::Create(desc);
+
+  std::atomic_int ran = 0;
+  for (int i = 0; i < 20; i++) {
+    pool->schedule(Task::Of([&ran]() {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      ran++;
+    }));
+  }
+  pool = nullptr;
+
+  EXPECT_EQ(ran, 20);
+}
+
+TEST(BlockingPool, acceptsPromiseContinuations) {
+  auto pool = BlockingPool::Create();
+
+  auto rsl = Promise<int>::Immediate(20)->then(
+      [](const int& v) { return v + 1; }, pool);
+
+  ASSERT_TRUE(::spin_until([rsl]() { return rsl->is_finished(); }));
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 21);
+}
+
+TEST(BlockingPool, runBlockingUsesDefaultPool) {
+  auto tl = TaskList::Create();
+
+  auto rsl = run_blocking([]() { return std::string("blocking"); }, tl);
+
+  ASSERT_TRUE(::spin_until([tl, rsl]() {
+    tl->execute_next();
+    return rsl->is_finished();
+  }));
+  EXPECT_EQ(rsl->unsafe_sync_peek(), "blocking");
+  EXPECT_GE(BlockingPool::Default()->thread_count(), 1);
+}
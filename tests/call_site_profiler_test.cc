@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <igasync/call_site_profiler.h>
+#include <igasync/task_list.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+
+class CapturingExecutionContext : public ExecutionContext {
+ public:
+  virtual void schedule(std::unique_ptr<Task> task) override {
+    last_task = std::move(task);
+  }
+
+  std::unique_ptr<Task> last_task;
+};
+
+const CallSiteStats* find_named(const std::vector<CallSiteStats>& stats,
+                                const char* name) {
+  for (const auto& s : stats) {
+    if (s.Name != nullptr && std::strcmp(s.Name, name) == 0) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+TEST(TaskLabel, capturesCallerLocation) {
+  TaskLabel label;
+  EXPECT_EQ(label.Name, nullptr);
+  EXPECT_EQ(label.Location.line(), __LINE__ - 2);
+
+  TaskLabel named = "named";
+  EXPECT_STREQ(named.Name, "named");
+  EXPECT_EQ(named.Location.line(), __LINE__ - 2);
+}
+
+TEST(TaskLabel, promiseContinuationsCarryCallSite) {
+  auto ctx = std::make_shared<::CapturingExecutionContext>();
+  auto p = Promise<int>::Immediate(2);
+
+  p->on_resolve([](const int&) {}, ctx);
+  ASSERT_NE(ctx->last_task, nullptr);
+  EXPECT_EQ(ctx->last_task->label().Name, nullptr);
+  EXPECT_EQ(ctx->last_task->label().Location.line(), __LINE__ - 3);
+
+  p->then([](const int& v) { return v * 2; }, ctx, "double it");
+  ASSERT_NE(ctx->last_task, nullptr);
+  EXPECT_STREQ(ctx->last_task->label().Name, "double it");
+  EXPECT_EQ(ctx->last_task->label().Location.line(), __LINE__ - 3);
+}
+
+TEST(CallSiteProfiler, aggregatesByCallSite) {
+  auto tl = TaskList::Create();
+  CallSiteProfiler::Get().start();
+
+  for (int i = 0; i < 10; i++) {
+    tl->run("cheap task", []() {});
+  }
+  tl->run("expensive task", []() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  });
+
+  auto p = Promise<int>::Create();
+  p->then([](const int& v) { return v + 1; }, tl, "continuation");
+  p->resolve(1);
+
+  ::flush_task_list(tl);
+  CallSiteProfiler::Get().stop();
+
+  auto stats = CallSiteProfiler::Get().snapshot();
+
+  auto cheap = ::find_named(stats, "cheap task");
+  ASSERT_NE(cheap, nullptr);
+  EXPECT_EQ(cheap->Count, 10);
+
+  auto expensive = ::find_named(stats, "expensive task");
+  ASSERT_NE(expensive, nullptr);
+  EXPECT_EQ(expensive->Count, 1);
+  EXPECT_GE(expensive->RunTimeP99, std::chrono::milliseconds(1));
+
+  auto continuation = ::find_named(stats, "continuation");
+  ASSERT_NE(continuation, nullptr);
+  EXPECT_EQ(continuation->Count, 1);
+
+  // Most expensive call site is reported first
+  EXPECT_STREQ(stats[0].Name, "expensive task");
+
+  std::stringstream report;
+  CallSiteProfiler::Get().write_report(report);
+  EXPECT_NE(report.str().find("expensive task"), std::string::npos);
+}
+
+TEST(CallSiteProfiler, recordsNothingWhenStopped) {
+  auto tl = TaskList::Create();
+  CallSiteProfiler::Get().start();
+  CallSiteProfiler::Get().stop();
+
+  tl->run("ignored", []() {});
+  ::flush_task_list(tl);
+
+  EXPECT_EQ(::find_named(CallSiteProfiler::Get().snapshot(), "ignored"),
+            nullptr);
+}
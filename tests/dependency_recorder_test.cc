@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <igasync/dependency_recorder.h>
+#include <igasync/promise_combiner.h>
+#include <igasync/task_list.h>
+
+#include <sstream>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+TEST(DependencyRecorder, followsThenChain) {
+  auto tl = TaskList::Create();
+  DependencyRecorder::Get().start();
+
+  auto root = Promise<int>::Create();
+  auto doubled = root->then([](const int& v) { return v * 2; }, tl, "double");
+  auto stringified =
+      doubled->then([](const int& v) { return std::to_string(v); }, tl, "str");
+
+  root->resolve(2);
+  ::flush_task_list(tl);
+  DependencyRecorder::Get().stop();
+
+  auto path = DependencyRecorder::Get().critical_path(stringified);
+  ASSERT_EQ(path.size(), 3);
+  EXPECT_EQ(path[0].Promise, root.get());
+  EXPECT_EQ(path[0].Predecessor, nullptr);
+  EXPECT_EQ(path[1].Promise, doubled.get());
+  EXPECT_EQ(path[1].Predecessor, root.get());
+  EXPECT_STREQ(path[1].ProducerLabel.Name, "double");
+  EXPECT_EQ(path[2].Promise, stringified.get());
+  EXPECT_STREQ(path[2].ProducerLabel.Name, "str");
+}
+
+TEST(DependencyRecorder, findsCombinerStraggler) {
+  auto tl = TaskList::Create();
+  DependencyRecorder::Get().start();
+
+  auto fast = Promise<int>::Create();
+  auto slow = Promise<int>::Create();
+  auto slow_stage = slow->then([](const int& v) { return v + 1; }, tl, "slow");
+
+  auto combiner = PromiseCombiner::Create();
+  auto fast_key = combiner->add(fast, tl);
+  auto slow_key = combiner->add(slow_stage, tl);
+  auto combined = combiner->combine(
+      [fast_key, slow_key](PromiseCombiner::Result rsl) {
+        return rsl.get(fast_key) + rsl.get(slow_key);
+      },
+      tl);
+
+  fast->resolve(1);
+  ::flush_task_list(tl);
+  slow->resolve(2);
+  ::flush_task_list(tl);
+  DependencyRecorder::Get().stop();
+
+  ASSERT_TRUE(combined->is_finished());
+  auto path = DependencyRecorder::Get().critical_path(combined);
+
+  bool has_slow = false, has_fast = false;
+  for (const auto& node : path) {
+    has_slow |= node.Promise == slow.get();
+    has_fast |= node.Promise == fast.get();
+  }
+  EXPECT_TRUE(has_slow);
+  EXPECT_FALSE(has_fast);
+  EXPECT_EQ(path.front().Promise, slow.get());
+  EXPECT_EQ(path.back().Promise, combined.get());
+
+  std::stringstream report;
+  DependencyRecorder::Get().write_report(report, combined.get());
+  EXPECT_NE(report.str().find("slow"), std::string::npos);
+  EXPECT_NE(report.str().find("Critical path"), std::string::npos);
+}
+
+TEST(DependencyRecorder, recordsNothingWhenStopped) {
+  DependencyRecorder::Get().start();
+  DependencyRecorder::Get().stop();
+
+  auto p = Promise<void>::Create();
+  p->resolve();
+
+  EXPECT_EQ(DependencyRecorder::Get().node_count(), 0);
+  EXPECT_TRUE(DependencyRecorder::Get().critical_path(p).empty());
+}
+
+TEST(DependencyRecorder, stopsGrowingAtCapacity) {
+  DependencyRecorder::Get().start(2);
+
+  for (int i = 0; i < 5; i++) {
+    Promise<int>::Immediate(i);
+  }
+  DependencyRecorder::Get().stop();
+
+  EXPECT_EQ(DependencyRecorder::Get().node_count(), 2);
+}
@@ -1,6 +1,12 @@
 #ifndef IGASYNC_TESTS_INCLUDE_TEST_OBJECTS_H
 #define IGASYNC_TESTS_INCLUDE_TEST_OBJECTS_H
 
+#include <igasync/execution_context.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace igasync {
 
 class NonCopyableObject {
@@ -37,6 +43,41 @@ class DestructorTracker {
   int* p_;
 };
 
+// Counts schedule and schedule_bulk calls. Tasks are forwarded to the inner
+// context if there is one, and run inline otherwise.
+class BulkCountingExecutionContext : public ExecutionContext {
+ public:
+  BulkCountingExecutionContext(
+      std::shared_ptr<ExecutionContext> inner = nullptr)
+      : inner_(std::move(inner)), schedule_ct(0), bulk_ct(0) {}
+
+  virtual void schedule(std::unique_ptr<Task> task) override {
+    schedule_ct++;
+    if (inner_) {
+      inner_->schedule(std::move(task));
+    } else {
+      task->run();
+    }
+  }
+
+  virtual void schedule_bulk(
+      std::vector<std::unique_ptr<Task>> tasks) override {
+    bulk_ct++;
+    if (inner_) {
+      inner_->schedule_bulk(std::move(tasks));
+      return;
+    }
+
+    for (auto& task : tasks) {
+      task->run();
+    }
+  }
+
+  std::shared_ptr<ExecutionContext> inner_;
+  int schedule_ct;
+  int bulk_ct;
+};
+
 }  // namespace igasync
 
 #endif
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <igasync/instrumentation.h>
+#include <igasync/task_list.h>
+#include <igasync/thread_pool.h>
+
+using namespace igasync;
+
+namespace {
+class CountingObserver : public IInstrumentationObserver {
+ public:
+  virtual void on_task_scheduled(const Task&,
+                                 const ExecutionContext&) override {
+    scheduled++;
+  }
+  virtual void on_task_started(const Task&) override { started++; }
+  virtual void on_task_finished(const Task&) override { finished++; }
+  virtual void on_promise_created(const void*) override { promises_created++; }
+  virtual void on_promise_resolved(const void*) override {
+    promises_resolved++;
+  }
+  virtual void on_worker_parked(size_t) override { parked++; }
+  virtual void on_worker_unparked(size_t) override { unparked++; }
+
+  std::atomic_int scheduled{0};
+  std::atomic_int started{0};
+  std::atomic_int finished{0};
+  std::atomic_int promises_created{0};
+  std::atomic_int promises_resolved{0};
+  std::atomic_int parked{0};
+  std::atomic_int unparked{0};
+};
+
+// Removes the observer even if an assertion fails
+struct ScopedObserver {
+  ScopedObserver(IInstrumentationObserver* observer) : observer(observer) {
+    Instrumentation::add_observer(observer);
+  }
+  ~ScopedObserver() { Instrumentation::remove_observer(observer); }
+  IInstrumentationObserver* observer;
+};
+}  // namespace
+
+TEST(Instrumentation, observerSlotsAreLimited) {
+  std::vector<::CountingObserver> observers(Instrumentation::kMaxObservers +
+                                            1);
+
+  for (size_t i = 0; i < Instrumentation::kMaxObservers; i++) {
+    EXPECT_TRUE(Instrumentation::add_observer(&observers[i]));
+  }
+  EXPECT_FALSE(Instrumentation::add_observer(&observers.back()));
+
+  Instrumentation::remove_observer(&observers[0]);
+  EXPECT_TRUE(Instrumentation::add_observer(&observers.back()));
+
+  for (size_t i = 1; i < observers.size(); i++) {
+    Instrumentation::remove_observer(&observers[i]);
+  }
+}
+
+TEST(Instrumentation, emitsTaskAndPromiseEvents) {
+  if (!Instrumentation::is_compiled_in()) {
+    GTEST_SKIP() << "Built without IGASYNC_ENABLE_INSTRUMENTATION";
+  }
+
+  ::CountingObserver observer;
+  ::ScopedObserver scoped(&observer);
+
+  auto tl = TaskList::Create();
+  auto p = Promise<int>::Create();
+  p->on_resolve([](const int&) {}, tl);
+  p->resolve(1);
+  while (tl->execute_next())
+    ;
+
+  EXPECT_EQ(observer.promises_created, 1);
+  EXPECT_EQ(observer.promises_resolved, 1);
+  EXPECT_EQ(observer.scheduled, 1);
+  EXPECT_EQ(observer.started, 1);
+  EXPECT_EQ(observer.finished, 1);
+}
+
+TEST(Instrumentation, emitsNothingAfterRemoval) {
+  ::CountingObserver observer;
+  Instrumentation::add_observer(&observer);
+  Instrumentation::remove_observer(&observer);
+
+  auto tl = TaskList::Create();
+  tl->run([]() {});
+  while (tl->execute_next())
+    ;
+
+  EXPECT_EQ(observer.scheduled, 0);
+  EXPECT_EQ(observer.started, 0);
+}
+
+TEST(Instrumentation, emitsWorkerParkEvents) {
+  if (!Instrumentation::is_compiled_in()) {
+    GTEST_SKIP() << "Built without IGASYNC_ENABLE_INSTRUMENTATION";
+  }
+
+  ::CountingObserver observer;
+  ::ScopedObserver scoped(&observer);
+
+  auto tl = TaskList::Create();
+  ThreadPool::Desc desc{};
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 1;
+  auto pool = ThreadPool::Create(desc);
+  pool->add_task_list(tl);
+
+  // Wait for the worker to run out of work and park
+  for (int i = 0; i < 1000 && observer.parked == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_GT(observer.parked, 0);
+
+  auto p = tl->run([]() {});
+  while (!p->is_finished()) {
+    std::this_thread::yield();
+  }
+  EXPECT_GT(observer.unparked, 0);
+
+  pool->clear_all_task_lists();
+}
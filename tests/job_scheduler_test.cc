@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <igasync/job_scheduler.h>
+#include <igasync/thread_pool.h>
+
+#include <vector>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+
+void noop() {}
+}  // namespace
+
+TEST(JobScheduler, internsResourceNames) {
+  auto scheduler = JobScheduler::Create();
+
+  auto a = scheduler->resource("transforms");
+  auto b = scheduler->resource("velocities");
+
+  EXPECT_NE(a, b);
+  EXPECT_EQ(scheduler->resource("transforms"), a);
+}
+
+TEST(JobScheduler, readersRunConcurrently) {
+  auto scheduler = JobScheduler::Create();
+  auto r = scheduler->resource("r");
+
+  auto writer = scheduler->add_job(::noop, {}, {r});
+  auto reader_1 = scheduler->add_job(::noop, {r}, {});
+  auto reader_2 = scheduler->add_job(::noop, {r}, {});
+
+  EXPECT_TRUE(scheduler->dependencies_of(writer).empty());
+  EXPECT_EQ(scheduler->dependencies_of(reader_1),
+            std::vector<JobScheduler::JobId>{writer});
+  EXPECT_EQ(scheduler->dependencies_of(reader_2),
+            std::vector<JobScheduler::JobId>{writer});
+}
+
+TEST(JobScheduler, writersWaitForPreviousReaders) {
+  auto scheduler = JobScheduler::Create();
+  auto r = scheduler->resource("r");
+
+  auto writer = scheduler->add_job(::noop, {}, {r});
+  auto reader_1 = scheduler->add_job(::noop, {r}, {});
+  auto reader_2 = scheduler->add_job(::noop, {r}, {});
+  auto writer_2 = scheduler->add_job(::noop, {}, {r});
+  auto writer_3 = scheduler->add_job(::noop, {r}, {r});
+
+  EXPECT_EQ(scheduler->dependencies_of(reader_1),
+            std::vector<JobScheduler::JobId>{writer});
+  EXPECT_EQ(scheduler->dependencies_of(writer_2),
+            (std::vector<JobScheduler::JobId>{reader_1, reader_2}));
+  EXPECT_EQ(scheduler->dependencies_of(writer_3),
+            std::vector<JobScheduler::JobId>{writer_2});
+}
+
+TEST(JobScheduler, unrelatedResourcesDoNotConflict) {
+  auto scheduler = JobScheduler::Create();
+  auto a = scheduler->resource("a");
+  auto b = scheduler->resource("b");
+
+  scheduler->add_job(::noop, {}, {a});
+  auto b_writer = scheduler->add_job(::noop, {}, {b});
+
+  EXPECT_TRUE(scheduler->dependencies_of(b_writer).empty());
+}
+
+TEST(JobScheduler, ignoresUnknownResources) {
+  auto scheduler = JobScheduler::Create();
+  auto r = scheduler->resource("r");
+  JobScheduler::ResourceId unknown = r + 1;
+
+  auto writer = scheduler->add_job(::noop, {}, {r, unknown});
+  auto unknown_writer = scheduler->add_job(::noop, {unknown}, {unknown});
+  auto reader = scheduler->add_job(::noop, {r, unknown}, {});
+
+  EXPECT_TRUE(scheduler->dependencies_of(unknown_writer).empty());
+  EXPECT_EQ(scheduler->dependencies_of(reader),
+            std::vector<JobScheduler::JobId>{writer});
+}
+
+TEST(JobScheduler, executesInConflictOrder) {
+  auto tl = TaskList::Create();
+  auto scheduler = JobScheduler::Create();
+  auto transforms = scheduler->resource("transforms");
+  auto velocities = scheduler->resource("velocities");
+
+  std::vector<std::string> order;
+  scheduler->add_job([&order]() { order.push_back("integrate"); },
+                     {velocities}, {transforms});
+  scheduler->add_job([&order]() { order.push_back("drag"); }, {},
+                     {velocities});
+  scheduler->add_job([&order]() { order.push_back("bounds"); }, {transforms},
+                     {});
+
+  for (int i = 0; i < 2; i++) {
+    order.clear();
+    auto p = scheduler->execute(tl);
+    ASSERT_NE(p, nullptr);
+    ::flush_task_list(tl);
+    EXPECT_TRUE(p->is_finished());
+
+    ASSERT_EQ(order.size(), 3);
+    EXPECT_EQ(order[0], "integrate");
+  }
+}
+
+TEST(JobScheduler, writersAreExclusiveOnThreadPool) {
+  ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 4;
+  auto thread_pool = ThreadPool::Create(desc);
+  auto tl = TaskList::Create();
+  thread_pool->add_task_list(tl);
+
+  auto scheduler = JobScheduler::Create();
+  auto counter_resource = scheduler->resource("counter");
+
+  // Unsynchronized counter - only safe because writers are serialized
+  int counter = 0;
+  for (int i = 0; i < 100; i++) {
+    scheduler->add_job([&counter]() { counter++; }, {}, {counter_resource});
+  }
+
+  auto p = scheduler->execute(tl);
+  ASSERT_NE(p, nullptr);
+  for (int i = 0; i < 500 && !p->is_finished(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(p->is_finished());
+  EXPECT_EQ(counter, 100);
+}
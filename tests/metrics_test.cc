@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <igasync/metrics.h>
+#include <igasync/task_list.h>
+#include <igasync/thread_pool.h>
+
+using namespace igasync;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogram, bucketsRoundTripWithinPrecision) {
+  std::vector<uint64_t> samples = {
+      0, 1, 7, 8, 15, 16, 1000, 123456789, 1ull << 62, UINT64_MAX};
+  for (uint64_t ns : samples) {
+    size_t idx = LatencyHistogram::bucket_index(ns);
+    ASSERT_LT(idx, LatencyHistogram::kBucketCount);
+
+    uint64_t lower = LatencyHistogram::bucket_lower_bound(idx);
+    EXPECT_LE(lower, ns);
+    EXPECT_LE(ns - lower, ns / LatencyHistogram::kSubBucketCount);
+  }
+}
+
+TEST(LatencyHistogram, reportsPercentiles) {
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 100; i++) {
+    histogram.record(std::chrono::microseconds(i));
+  }
+
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.Count, 100);
+  EXPECT_EQ(snapshot.max(), 100us);
+  EXPECT_NEAR((double)snapshot.mean().count(), 50500., 1.);
+
+  auto p50 = snapshot.percentile(0.5);
+  EXPECT_GE(p50, 50us);
+  EXPECT_LE(p50, 57us);
+
+  auto p99 = snapshot.percentile(0.99);
+  EXPECT_GE(p99, 99us);
+  EXPECT_LE(p99, 100us);
+}
+
+TEST(LatencyHistogram, emptyHistogramReportsZero) {
+  LatencyHistogram histogram;
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.Count, 0);
+  EXPECT_EQ(snapshot.percentile(0.99), 0ns);
+  EXPECT_EQ(snapshot.mean(), 0ns);
+}
+
+TEST(TaskListMetrics, reportsQueueDepthWithoutCollectingMetrics) {
+  auto tl = TaskList::Create();
+  tl->run([]() {});
+  tl->run([]() {});
+
+  auto m = tl->metrics();
+  EXPECT_EQ(m.QueueDepth, 2);
+  EXPECT_EQ(m.Enqueued, 0);
+  EXPECT_EQ(m.ScheduleToStart.Count, 0);
+}
+
+TEST(TaskListMetrics, countsTasksAndLatencies) {
+  TaskList::Desc desc;
+  desc.CollectMetrics = true;
+  auto tl = TaskList::Create(desc);
+
+  for (int i = 0; i < 5; i++) {
+    tl->run([]() {});
+  }
+
+  auto m = tl->metrics();
+  EXPECT_EQ(m.QueueDepth, 5);
+  EXPECT_EQ(m.Enqueued, 5);
+  EXPECT_EQ(m.Dequeued, 0);
+
+  tl->execute_next();
+  tl->execute_next();
+  tl->execute_next();
+
+  m = tl->metrics();
+  EXPECT_EQ(m.QueueDepth, 2);
+  EXPECT_EQ(m.Enqueued, 5);
+  EXPECT_EQ(m.Dequeued, 3);
+  EXPECT_EQ(m.ScheduleToStart.Count, 3);
+  EXPECT_EQ(m.RunTime.Count, 3);
+}
+
+TEST(ThreadPoolMetrics, countsTasksPerWorker) {
+  auto tl = TaskList::Create();
+  ThreadPool::Desc desc{};
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 2;
+  auto pool = ThreadPool::Create(desc);
+  pool->add_task_list(tl);
+
+  std::vector<std::shared_ptr<Promise<void>>> promises;
+  for (int i = 0; i < 50; i++) {
+    promises.push_back(tl->run([]() {}));
+  }
+  for (auto& p : promises) {
+    while (!p->is_finished()) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Task counts are bumped after the task (and its promise) finishes
+  auto m = pool->metrics();
+  for (int i = 0; i < 1000 && m.total_tasks_executed() < 50; i++) {
+    std::this_thread::sleep_for(1ms);
+    m = pool->metrics();
+  }
+
+  ASSERT_EQ(m.Workers.size(), 2);
+  EXPECT_EQ(m.total_tasks_executed(), 50);
+  EXPECT_GE(m.utilization(), 0.);
+  EXPECT_LE(m.utilization(), 1.);
+}
+
+TEST(ThreadPoolMetrics, countsTaskRunOnWakeupAsBusy) {
+  auto tl = TaskList::Create();
+  ThreadPool::Desc desc{};
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 1;
+  auto pool = ThreadPool::Create(desc);
+  pool->add_task_list(tl);
+
+  auto wait_for_parks = [pool](uint64_t parks) {
+    for (int i = 0; i < 1000 && pool->metrics().Workers[0].Parks < parks;
+         i++) {
+      std::this_thread::sleep_for(1ms);
+    }
+  };
+  wait_for_parks(1);
+
+  // One task per wakeup - the worker parks again after each of them
+  const int kWakeupCount = 5;
+  for (int i = 0; i < kWakeupCount; i++) {
+    auto parks = pool->metrics().Workers[0].Parks;
+    auto p = tl->run([]() { std::this_thread::sleep_for(5ms); });
+    while (!p->is_finished()) {
+      std::this_thread::yield();
+    }
+    wait_for_parks(parks + 1);
+  }
+
+  auto m = pool->metrics();
+  ASSERT_EQ(m.Workers.size(), 1);
+  EXPECT_EQ(m.total_tasks_executed(), kWakeupCount);
+  EXPECT_GE(m.Workers[0].BusyTime, kWakeupCount * 5ms);
+}
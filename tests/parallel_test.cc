@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <igasync/parallel.h>
+#include <igasync/thread_pool.h>
+
+#include <vector>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+
+std::shared_ptr<ThreadPool> CreateTestThreadPool() {
+  ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 4;
+
+  return ThreadPool::Create(desc);
+}
+
+void sleep_until_finished(std::shared_ptr<Promise<void>> promise) {
+  for (int i = 0; i < 500 && !promise->is_finished(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+}
+}  // namespace
+
+TEST(RangePartitioner, claimsEveryIndexExactlyOnce) {
+  ParallelDesc desc;
+  desc.Concurrency = 4;
+  desc.GrainSize = 3;
+  RangePartitioner partitioner(100, desc);
+
+  std::vector<int> claimed(100, 0);
+  size_t chunk_begin = 0, chunk_end = 0;
+  size_t last_chunk_size = 100;
+  int finished_ct = 0;
+  while (partitioner.claim(chunk_begin, chunk_end)) {
+    EXPECT_LE(chunk_end - chunk_begin, last_chunk_size);
+    last_chunk_size = chunk_end - chunk_begin;
+    for (size_t i = chunk_begin; i < chunk_end; i++) {
+      claimed[i]++;
+    }
+    if (partitioner.complete(chunk_end - chunk_begin)) {
+      finished_ct++;
+    }
+  }
+
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(claimed[i], 1);
+  }
+  EXPECT_EQ(finished_ct, 1);
+}
+
+TEST(RangePartitioner, picksGrainSizeAutomatically) {
+  ParallelDesc desc;
+  desc.Concurrency = 4;
+  RangePartitioner partitioner(100000, desc);
+
+  EXPECT_GT(partitioner.grain_size(), 1);
+  EXPECT_LT(partitioner.grain_size(), 100000 / 4);
+  EXPECT_EQ(partitioner.helper_count(true), 3);
+  EXPECT_EQ(partitioner.helper_count(false), 4);
+}
+
+TEST(ParallelFor, emptyRangeResolvesImmediately) {
+  auto tl = TaskList::Create();
+
+  int call_ct = 0;
+  auto p = parallel_for(5, 5, [&call_ct](int) { call_ct++; }, tl);
+
+  EXPECT_TRUE(p->is_finished());
+  EXPECT_EQ(call_ct, 0);
+  EXPECT_FALSE(tl->execute_next());
+}
+
+TEST(ParallelFor, callingThreadParticipates) {
+  auto tl = TaskList::Create();
+
+  std::vector<int> visited(1000, 0);
+  auto p = parallel_for(
+      size_t{0}, visited.size(), [&visited](size_t i) { visited[i]++; }, tl);
+
+  // Only the calling thread has done any work - and it did all of it
+  EXPECT_TRUE(p->is_finished());
+  for (size_t i = 0; i < visited.size(); i++) {
+    EXPECT_EQ(visited[i], 1);
+  }
+
+  // Helper tasks find nothing left to do
+  ::flush_task_list(tl);
+}
+
+TEST(ParallelFor, runsOnTaskListWithoutCaller) {
+  auto tl = TaskList::Create();
+
+  ParallelDesc desc;
+  desc.CallerParticipates = false;
+
+  std::vector<int> visited(100, 0);
+  auto p = parallel_for(
+      -50, 50, [&visited](int i) { visited[i + 50]++; }, tl, desc);
+
+  EXPECT_FALSE(p->is_finished());
+  ::flush_task_list(tl);
+  EXPECT_TRUE(p->is_finished());
+
+  for (size_t i = 0; i < visited.size(); i++) {
+    EXPECT_EQ(visited[i], 1);
+  }
+}
+
+TEST(ParallelFor, spreadsWorkOverThreadPool) {
+  auto thread_pool = ::CreateTestThreadPool();
+  auto tl = TaskList::Create();
+  thread_pool->add_task_list(tl);
+
+  ParallelDesc desc;
+  desc.CallerParticipates = false;
+  desc.Concurrency = 4;
+
+  std::vector<std::atomic_int> visited(100000);
+  auto p = parallel_for(
+      size_t{0}, visited.size(), [&visited](size_t i) { visited[i]++; }, tl,
+      desc);
+
+  ::sleep_until_finished(p);
+  ASSERT_TRUE(p->is_finished());
+
+  for (size_t i = 0; i < visited.size(); i++) {
+    EXPECT_EQ(visited[i].load(), 1);
+  }
+}
+
+TEST(ParallelReduce, emptyRangeResolvesWithIdentity) {
+  auto tl = TaskList::Create();
+
+  auto p = parallel_reduce(
+      0, 0, 7, [](int& acc, int i) { acc += i; },
+      [](int& acc, int partial) { acc += partial; }, tl);
+
+  ASSERT_TRUE(p->is_finished());
+  EXPECT_EQ(p->unsafe_sync_peek(), 7);
+}
+
+TEST(ParallelReduce, reducesOnTaskList) {
+  auto tl = TaskList::Create();
+
+  ParallelDesc desc;
+  desc.CallerParticipates = false;
+  desc.Concurrency = 4;
+
+  auto p = parallel_reduce(
+      int64_t{1}, int64_t{1001}, int64_t{0},
+      [](int64_t& acc, int64_t i) { acc += i; },
+      [](int64_t& acc, int64_t partial) { acc += partial; }, tl, desc);
+
+  EXPECT_FALSE(p->is_finished());
+  ::flush_task_list(tl);
+  ASSERT_TRUE(p->is_finished());
+  EXPECT_EQ(p->unsafe_sync_peek(), 500500);
+}
+
+TEST(ParallelReduce, reducesOverThreadPool) {
+  auto thread_pool = ::CreateTestThreadPool();
+  auto tl = TaskList::Create();
+  thread_pool->add_task_list(tl);
+
+  ParallelDesc desc;
+  desc.CallerParticipates = false;
+
+  auto p = parallel_reduce(
+      size_t{0}, size_t{100000}, size_t{0},
+      [](size_t& acc, size_t i) { acc += i; },
+      [](size_t& acc, size_t partial) { acc += partial; }, tl, desc);
+
+  for (int i = 0; i < 500 && !p->is_finished(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  ASSERT_TRUE(p->is_finished());
+  EXPECT_EQ(p->unsafe_sync_peek(), size_t{100000} * 99999 / 2);
+}
+
+TEST(ParallelReduce, deterministicModeCombinesInChunkOrder) {
+  auto tl = TaskList::Create();
+
+  ParallelDesc desc;
+  desc.Deterministic = true;
+  desc.GrainSize = 10;
+  desc.CallerParticipates = false;
+
+  // Concatenation is not commutative - any out-of-order combine shows up
+  auto p = parallel_reduce(
+      0, 100, std::string{},
+      [](std::string& acc, int i) { acc += (char)('0' + (i / 10)); },
+      [](std::string& acc, std::string partial) { acc += partial; }, tl,
+      desc);
+  ::flush_task_list(tl);
+
+  std::string expected;
+  for (int i = 0; i < 100; i++) {
+    expected += (char)('0' + (i / 10));
+  }
+
+  ASSERT_TRUE(p->is_finished());
+  EXPECT_EQ(p->unsafe_sync_peek(), expected);
+}
+
+TEST(ParallelInclusiveScan, matchesSerialScan) {
+  auto tl = TaskList::Create();
+
+  std::vector<int> in(1000);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = (int)(i % 7) - 3;
+  }
+  std::vector<int> out(in.size(), 0);
+
+  ParallelDesc desc;
+  desc.GrainSize = 64;
+  desc.CallerParticipates = false;
+
+  auto p = parallel_inclusive_scan(
+      in.begin(), in.end(), out.begin(), 0,
+      [](const int& a, const int& b) { return a + b; }, tl, desc);
+  ::flush_task_list(tl);
+  ASSERT_TRUE(p->is_finished());
+
+  int running = 0;
+  for (size_t i = 0; i < in.size(); i++) {
+    running += in[i];
+    EXPECT_EQ(out[i], running);
+  }
+}
+
+TEST(ParallelInclusiveScan, scansInPlaceOverThreadPool) {
+  auto thread_pool = ::CreateTestThreadPool();
+  auto tl = TaskList::Create();
+  thread_pool->add_task_list(tl);
+
+  std::vector<int64_t> data(100000, 1);
+
+  auto p = parallel_inclusive_scan(
+      data.begin(), data.end(), data.begin(), int64_t{0},
+      [](const int64_t& a, const int64_t& b) { return a + b; }, tl);
+
+  ::sleep_until_finished(p);
+  ASSERT_TRUE(p->is_finished());
+
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(data[i], (int64_t)i + 1);
+  }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <igasync/promise_census.h>
+#include <igasync/task_list.h>
+
+#include <sstream>
+
+using namespace igasync;
+
+namespace {
+// Leaves the census disabled even if an assertion fails
+struct ScopedCensus {
+  ScopedCensus() { PromiseCensus::Get().enable(); }
+  ~ScopedCensus() { PromiseCensus::Get().disable(); }
+};
+}  // namespace
+
+TEST(PromiseCensus, tracksOnlyWhileEnabled) {
+  size_t base_count = PromiseCensus::Get().live_count();
+
+  auto untracked = Promise<int>::Create();
+  EXPECT_EQ(PromiseCensus::Get().live_count(), base_count);
+
+  {
+    ::ScopedCensus census;
+    auto tracked = Promise<int>::Create();
+    auto tracked_void = Promise<void>::Create();
+    EXPECT_EQ(PromiseCensus::Get().live_count(), base_count + 2);
+  }
+
+  EXPECT_EQ(PromiseCensus::Get().live_count(), base_count);
+}
+
+TEST(PromiseCensus, reportsPendingContinuationsAndCreationSite) {
+  ::ScopedCensus census;
+  auto tl = TaskList::Create();
+
+  auto p = Promise<int>::Create();
+  uint32_t created_line = __LINE__ - 1;
+  int big_capture[16] = {};
+  p->on_resolve([big_capture](const int&) {}, tl);
+  p->on_resolve([](const int&) {}, tl);
+
+  auto infos = PromiseCensus::Get().snapshot();
+  auto it = std::find_if(infos.begin(), infos.end(),
+                         [&p](const auto& i) { return i.Promise == p.get(); });
+  ASSERT_NE(it, infos.end());
+  EXPECT_FALSE(it->IsResolved);
+  EXPECT_EQ(it->Location.line(), created_line);
+  EXPECT_EQ(it->PendingContinuations, 2);
+  EXPECT_GE(it->CapturedBytes, sizeof(big_capture));
+
+  p->resolve(1);
+  infos = PromiseCensus::Get().snapshot();
+  EXPECT_EQ(std::count_if(infos.begin(), infos.end(),
+                          [&p](const auto& i) { return i.Promise == p.get(); }),
+            0);
+
+  infos = PromiseCensus::Get().snapshot(true);
+  it = std::find_if(infos.begin(), infos.end(),
+                    [&p](const auto& i) { return i.Promise == p.get(); });
+  ASSERT_NE(it, infos.end());
+  EXPECT_TRUE(it->IsResolved);
+  EXPECT_EQ(it->PendingContinuations, 0);
+
+  while (tl->execute_next())
+    ;
+}
+
+TEST(PromiseCensus, attributesThenResultToCaller) {
+  ::ScopedCensus census;
+  auto tl = TaskList::Create();
+
+  auto p = Promise<int>::Create();
+  auto chained = p->then([](const int& v) { return v; }, tl);
+  uint32_t then_line = __LINE__ - 1;
+
+  auto infos = PromiseCensus::Get().snapshot();
+  auto it = std::find_if(infos.begin(), infos.end(), [&chained](const auto& i) {
+    return i.Promise == chained.get();
+  });
+  ASSERT_NE(it, infos.end());
+  EXPECT_EQ(it->Location.line(), then_line);
+
+  std::stringstream report;
+  PromiseCensus::Get().write_report(report);
+  EXPECT_NE(report.str().find("promise_census_test.cc"), std::string::npos);
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <igasync/reactor.h>
+#include <igasync/task_list.h>
+
+#include "test_objects.h"
+
+#if defined(__linux__)
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace igasync;
+
+namespace {
+Reactor::Desc pumped_desc() {
+  Reactor::Desc desc;
+  desc.UseDedicatedThread = false;
+  return desc;
+}
+
+void write_str(int fd, const std::string& str) {
+  ASSERT_EQ(::write(fd, str.data(), str.size()), (ssize_t)str.size());
+}
+
+template <typename PredT>
+bool spin_until(PredT pred) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+TEST(Reactor, resolvesWhenPipeBecomesReadable) {
+  auto reactor = Reactor::Create(::pumped_desc());
+  ASSERT_NE(reactor, nullptr);
+  auto tl = TaskList::Create();
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+
+  auto readable = reactor->when_readable(fds[0], tl);
+  EXPECT_EQ(reactor->poll(), 0);
+  ::flush_task_list(tl);
+  EXPECT_FALSE(readable->is_finished());
+
+  ::write_str(fds[1], "x");
+  EXPECT_EQ(reactor->poll(), 1);
+  EXPECT_FALSE(readable->is_finished());
+  ::flush_task_list(tl);
+  EXPECT_TRUE(readable->is_finished());
+  EXPECT_EQ(reactor->watched_fd_count(), 0);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST(Reactor, readsAndWritesSocketpair) {
+  auto reactor = Reactor::Create(::pumped_desc());
+  auto tl = TaskList::Create();
+
+  int fds[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+  std::byte buffer[16] = {};
+  auto read = reactor->read_some(fds[1], buffer, tl);
+
+  const char* message = "hello";
+  auto written = reactor->write_some(
+      fds[0], std::as_bytes(std::span(message, 5)), tl);
+
+  // The write is served right away, the read once the data shows up
+  ASSERT_TRUE(::spin_until([reactor, tl, read]() {
+    reactor->poll(std::chrono::milliseconds(1));
+    ::flush_task_list(tl);
+    return read->is_finished();
+  }));
+  ASSERT_TRUE(written->is_finished());
+  EXPECT_EQ(written->unsafe_sync_peek(), 5);
+  EXPECT_EQ(read->unsafe_sync_peek(), 5);
+  EXPECT_EQ(std::memcmp(buffer, "hello", 5), 0);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST(Reactor, readResolvesZeroAtEndOfFile) {
+  auto reactor = Reactor::Create(::pumped_desc());
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+
+  std::byte buffer[4];
+  auto read = reactor->read_some(fds[0], buffer);
+  ::close(fds[1]);
+
+  reactor->poll(std::chrono::milliseconds(100));
+  ASSERT_TRUE(read->is_finished());
+  EXPECT_EQ(read->unsafe_sync_peek(), 0);
+
+  ::close(fds[0]);
+}
+
+TEST(Reactor, servesWaitersOnOneFdInOrder) {
+  auto reactor = Reactor::Create(::pumped_desc());
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+
+  std::byte first[2], second[2];
+  auto read1 = reactor->read_some(fds[0], first);
+  auto read2 = reactor->read_some(fds[0], second);
+
+  ::write_str(fds[1], "abcd");
+  reactor->poll(std::chrono::milliseconds(100));
+  reactor->poll(std::chrono::milliseconds(100));
+
+  ASSERT_TRUE(read1->is_finished());
+  ASSERT_TRUE(read2->is_finished());
+  EXPECT_EQ(std::memcmp(first, "ab", 2), 0);
+  EXPECT_EQ(std::memcmp(second, "cd", 2), 0);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST(Reactor, batchesCompletionsIntoOneBulkSchedule) {
+  auto reactor = Reactor::Create(::pumped_desc());
+  auto tl = TaskList::Create();
+  auto ctx = std::make_shared<BulkCountingExecutionContext>(tl);
+
+  int pipes[3][2];
+  std::vector<std::shared_ptr<Promise<void>>> readable;
+  for (auto& fds : pipes) {
+    ASSERT_EQ(::pipe(fds), 0);
+    readable.push_back(reactor->when_readable(fds[0], ctx));
+  }
+  for (auto& fds : pipes) {
+    ::write_str(fds[1], "x");
+  }
+
+  EXPECT_EQ(reactor->poll(std::chrono::milliseconds(100)), 3);
+  EXPECT_EQ(ctx->bulk_ct, 1);
+  EXPECT_EQ(ctx->schedule_ct, 0);
+
+  ::flush_task_list(tl);
+  for (auto& p : readable) {
+    EXPECT_TRUE(p->is_finished());
+  }
+
+  for (auto& fds : pipes) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+}
+
+TEST(Reactor, removeDropsWaiters) {
+  auto reactor = Reactor::Create(::pumped_desc());
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+
+  auto readable = reactor->when_readable(fds[0]);
+  EXPECT_EQ(reactor->watched_fd_count(), 1);
+  reactor->remove(fds[0]);
+  EXPECT_EQ(reactor->watched_fd_count(), 0);
+
+  ::write_str(fds[1], "x");
+  EXPECT_EQ(reactor->poll(std::chrono::milliseconds(10)), 0);
+  EXPECT_FALSE(readable->is_finished());
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST(Reactor, watchesTaskListReadiness) {
+  auto reactor = Reactor::Create(::pumped_desc());
+
+  TaskList::Desc desc;
+  desc.UseReadinessFd = true;
+  auto tl = TaskList::Create(desc);
+
+  auto has_tasks = reactor->when_readable(tl->readiness_fd());
+  EXPECT_EQ(reactor->poll(), 0);
+
+  std::thread([tl]() { tl->schedule(Task::Of([]() {})); }).join();
+  EXPECT_EQ(reactor->poll(std::chrono::milliseconds(100)), 1);
+  EXPECT_TRUE(has_tasks->is_finished());
+}
+
+TEST(Reactor, dedicatedThreadResolvesWithoutPolling) {
+  auto reactor = Reactor::Create();
+  auto tl = TaskList::Create();
+
+  int fds[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+  std::byte buffer[8];
+  auto read = reactor->read_some(fds[1], buffer, tl);
+  ::write_str(fds[0], "ping");
+
+  ASSERT_TRUE(::spin_until([tl, read]() {
+    ::flush_task_list(tl);
+    return read->is_finished();
+  }));
+  EXPECT_EQ(read->unsafe_sync_peek(), 4);
+
+  reactor = nullptr;
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+#endif
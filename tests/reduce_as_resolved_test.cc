@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <igasync/reduce_as_resolved.h>
+#include <igasync/thread_pool.h>
+
+#include "test_objects.h"
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+TEST(ReduceAsResolved, foldsAllValues) {
+  auto tl = TaskList::Create();
+
+  std::vector<std::shared_ptr<Promise<int>>> promises;
+  for (int i = 0; i < 5; i++) {
+    promises.push_back(Promise<int>::Create());
+  }
+
+  auto rsl = reduce_as_resolved(
+      promises, 0, [](int& acc, int v) { acc += v; }, tl);
+
+  for (int i = 0; i < 4; i++) {
+    promises[i]->resolve(i + 1);
+  }
+  ::flush_task_list(tl);
+  EXPECT_FALSE(rsl->is_finished());
+
+  promises[4]->resolve(5);
+  ::flush_task_list(tl);
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 15);
+}
+
+TEST(ReduceAsResolved, emptyListResolvesWithInit) {
+  auto tl = TaskList::Create();
+
+  auto rsl = reduce_as_resolved(
+      std::vector<std::shared_ptr<Promise<int>>>{}, 42,
+      [](int& acc, int v) { acc += v; }, tl);
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 42);
+}
+
+TEST(ReduceAsResolved, dropsInputsAsTheyAreFolded) {
+  auto tl = TaskList::Create();
+
+  int dtor_ct = 0;
+  int fold_ct = 0;
+
+  auto p1 = Promise<DestructorTracker>::Create();
+  auto p2 = Promise<DestructorTracker>::Create();
+
+  auto rsl = reduce_as_resolved(
+      std::vector<std::shared_ptr<Promise<DestructorTracker>>>{p1, p2}, 0,
+      [&fold_ct](int&, DestructorTracker) { fold_ct++; }, tl);
+
+  p1->resolve(DestructorTracker(&dtor_ct));
+  ::flush_task_list(tl);
+
+  EXPECT_EQ(fold_ct, 1);
+  EXPECT_EQ(dtor_ct, 1);
+  EXPECT_FALSE(rsl->is_finished());
+
+  p2->resolve(DestructorTracker(&dtor_ct));
+  ::flush_task_list(tl);
+
+  EXPECT_EQ(fold_ct, 2);
+  EXPECT_EQ(dtor_ct, 2);
+  EXPECT_TRUE(rsl->is_finished());
+}
+
+TEST(ReduceAsResolved, foldsMoveOnlyValues) {
+  auto tl = TaskList::Create();
+
+  std::vector<std::shared_ptr<Promise<NonCopyableObject>>> promises = {
+      Promise<NonCopyableObject>::Immediate(NonCopyableObject(3)),
+      Promise<NonCopyableObject>::Immediate(NonCopyableObject(4))};
+
+  auto rsl = reduce_as_resolved(
+      promises, 1,
+      [](int& acc, NonCopyableObject v) { acc *= v.InnerValue; }, tl);
+  ::flush_task_list(tl);
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 12);
+}
+
+TEST(ReduceAsResolved, shardedFoldMergesPartialsFromWorkers) {
+  ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 4;
+  auto thread_pool = ThreadPool::Create(desc);
+  auto tl = TaskList::Create();
+  thread_pool->add_task_list(tl);
+
+  std::vector<std::shared_ptr<Promise<int64_t>>> promises;
+  int64_t expected = 0;
+  for (int64_t i = 0; i < 1000; i++) {
+    promises.push_back(Promise<int64_t>::Immediate(i));
+    expected += i;
+  }
+
+  auto rsl = reduce_as_resolved(
+      promises, int64_t{0}, [](int64_t& acc, int64_t v) { acc += v; },
+      [](int64_t& acc, int64_t partial) { acc += partial; }, tl);
+
+  for (int i = 0; i < 500 && !rsl->is_finished(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek(), expected);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <igasync/task_graph.h>
+#include <igasync/thread_pool.h>
+
+#include <mutex>
+#include <vector>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+TEST(TaskGraph, emptyGraphResolvesImmediately) {
+  auto tl = TaskList::Create();
+  auto graph = TaskGraph::Create();
+
+  auto p = graph->execute(tl);
+  ASSERT_NE(p, nullptr);
+  EXPECT_TRUE(p->is_finished());
+}
+
+TEST(TaskGraph, respectsEdges) {
+  auto tl = TaskList::Create();
+  auto graph = TaskGraph::Create();
+
+  std::vector<int> order;
+  auto a = graph->add_node([&order]() { order.push_back(0); });
+  auto b = graph->add_node([&order]() { order.push_back(1); });
+  auto c = graph->add_node([&order]() { order.push_back(2); });
+  auto d = graph->add_node([&order]() { order.push_back(3); });
+
+  // Declared out of order on purpose: d <- b <- c <- a
+  graph->add_edge(c, b);
+  graph->add_edge(a, c);
+  graph->add_edge(b, d);
+
+  auto p = graph->execute(tl);
+  ASSERT_NE(p, nullptr);
+  EXPECT_FALSE(p->is_finished());
+  ::flush_task_list(tl);
+  EXPECT_TRUE(p->is_finished());
+
+  ASSERT_EQ(order.size(), 4);
+  EXPECT_EQ(order[0], 0);
+  EXPECT_EQ(order[1], 2);
+  EXPECT_EQ(order[2], 1);
+  EXPECT_EQ(order[3], 3);
+}
+
+TEST(TaskGraph, rejectsCycles) {
+  auto tl = TaskList::Create();
+  auto graph = TaskGraph::Create();
+
+  auto a = graph->add_node([]() {});
+  auto b = graph->add_node([]() {});
+  graph->add_edge(a, b);
+  graph->add_edge(b, a);
+
+  EXPECT_FALSE(graph->compile());
+  EXPECT_EQ(graph->execute(tl), nullptr);
+}
+
+TEST(TaskGraph, rejectsOverlappingExecutions) {
+  auto tl = TaskList::Create();
+  auto graph = TaskGraph::Create();
+  graph->add_node([]() {});
+
+  auto p1 = graph->execute(tl);
+  ASSERT_NE(p1, nullptr);
+  EXPECT_TRUE(graph->is_running());
+  EXPECT_EQ(graph->execute(tl), nullptr);
+
+  ::flush_task_list(tl);
+  EXPECT_TRUE(p1->is_finished());
+  EXPECT_FALSE(graph->is_running());
+}
+
+TEST(TaskGraph, executesRepeatedly) {
+  auto tl = TaskList::Create();
+  auto graph = TaskGraph::Create();
+
+  int root_ct = 0, left_ct = 0, right_ct = 0, join_ct = 0;
+  auto root = graph->add_node([&root_ct]() { root_ct++; });
+  auto left = graph->add_node([&left_ct]() { left_ct++; });
+  auto right = graph->add_node([&right_ct]() { right_ct++; });
+  auto join = graph->add_node([&]() {
+    EXPECT_EQ(left_ct, root_ct);
+    EXPECT_EQ(right_ct, root_ct);
+    join_ct++;
+  });
+  graph->add_edge(root, left);
+  graph->add_edge(root, right);
+  graph->add_edge(left, join);
+  graph->add_edge(right, join);
+
+  for (int i = 0; i < 10; i++) {
+    auto p = graph->execute(tl);
+    ASSERT_NE(p, nullptr);
+    ::flush_task_list(tl);
+    EXPECT_TRUE(p->is_finished());
+  }
+
+  EXPECT_EQ(root_ct, 10);
+  EXPECT_EQ(join_ct, 10);
+}
+
+TEST(TaskGraph, executesOnThreadPool) {
+  ThreadPool::Desc desc;
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 4;
+  auto thread_pool = ThreadPool::Create(desc);
+  auto tl = TaskList::Create();
+  thread_pool->add_task_list(tl);
+
+  auto graph = TaskGraph::Create();
+  std::atomic_int fan_ct = 0;
+  int observed_fan_ct = -1;
+
+  auto root = graph->add_node([]() {});
+  auto join = graph->add_node(
+      [&fan_ct, &observed_fan_ct]() { observed_fan_ct = fan_ct.load(); });
+  for (int i = 0; i < 32; i++) {
+    auto n = graph->add_node([&fan_ct]() { fan_ct++; });
+    graph->add_edge(root, n);
+    graph->add_edge(n, join);
+  }
+
+  for (int frame = 1; frame <= 5; frame++) {
+    auto p = graph->execute(tl);
+    ASSERT_NE(p, nullptr);
+    for (int i = 0; i < 500 && !p->is_finished(); i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(p->is_finished());
+    EXPECT_EQ(observed_fan_ct, 32 * frame);
+  }
+}
@@ -1,7 +1,15 @@
 #include <gtest/gtest.h>
 #include <igasync/task_list.h>
 
+#include <atomic>
+#include <thread>
 #include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 using namespace igasync;
 
@@ -23,6 +31,26 @@ class TestTaskScheduledListener : public ITaskScheduledListener {
   std::function<void()> cb_;
 };
 
+#if defined(__linux__)
+bool is_readable(int fd, int timeout_ms = 0) {
+  pollfd pfd{fd, POLLIN, 0};
+  return ::poll(&pfd, 1, timeout_ms) == 1;
+}
+#endif
+
+class BulkCountingListener : public ITaskScheduledListener {
+ public:
+  virtual void on_task_added() override { single_ct++; }
+  virtual void on_tasks_added(size_t count) override {
+    bulk_ct++;
+    bulk_task_ct += count;
+  }
+
+  int single_ct = 0;
+  int bulk_ct = 0;
+  size_t bulk_task_ct = 0;
+};
+
 class NonCopyable {
  public:
   NonCopyable(int val) : val_(val) {}
@@ -121,6 +149,71 @@ TEST(TaskList, unregisteredListenersDoNotReceiveUpdatesOnSchedule) {
   EXPECT_EQ(tasks_scheduled, 1);
 }
 
+TEST(TaskList, scheduleBulkNotifiesListenersOncePerBatch) {
+  auto task_list = TaskList::Create();
+  auto listener = std::make_shared<::BulkCountingListener>();
+  task_list->register_listener(listener);
+
+  int executed = 0;
+  std::vector<std::unique_ptr<Task>> tasks;
+  for (int i = 0; i < 5; i++) {
+    tasks.push_back(Task::Of([&executed]() { executed++; }));
+  }
+  task_list->schedule_bulk(std::move(tasks));
+
+  EXPECT_EQ(listener->single_ct, 0);
+  EXPECT_EQ(listener->bulk_ct, 1);
+  EXPECT_EQ(listener->bulk_task_ct, 5);
+
+  ::flush_task_list(task_list.get());
+  EXPECT_EQ(executed, 5);
+}
+
+TEST(TaskList, scheduleBulkDefaultsToOneNotificationPerTask) {
+  int tasks_scheduled = 0;
+
+  auto task_list = TaskList::Create();
+  auto listener = std::make_shared<TestTaskScheduledListener>(
+      [&tasks_scheduled]() { tasks_scheduled++; });
+  task_list->register_listener(listener);
+
+  std::vector<std::unique_ptr<Task>> tasks;
+  tasks.push_back(Task::Of(::noop));
+  tasks.push_back(Task::Of(::noop));
+  task_list->schedule_bulk(std::move(tasks));
+
+  EXPECT_EQ(tasks_scheduled, 2);
+}
+
+TEST(TaskList, scheduleGroupedBulkSchedulesOncePerList) {
+  auto list_a = TaskList::Create();
+  auto list_b = TaskList::Create();
+  auto listener_a = std::make_shared<::BulkCountingListener>();
+  auto listener_b = std::make_shared<::BulkCountingListener>();
+  list_a->register_listener(listener_a);
+  list_b->register_listener(listener_b);
+
+  std::vector<int> order;
+  std::vector<ContextTask> tasks;
+  for (int i = 0; i < 4; i++) {
+    tasks.push_back({i % 2 == 0 ? list_a : list_b,
+                     Task::Of([&order, i]() { order.push_back(i); })});
+  }
+  bool ran_inline = false;
+  tasks.push_back({nullptr, Task::Of([&ran_inline]() { ran_inline = true; })});
+  schedule_grouped(std::move(tasks));
+
+  EXPECT_TRUE(ran_inline);
+  EXPECT_EQ(listener_a->bulk_ct, 1);
+  EXPECT_EQ(listener_a->bulk_task_ct, 2);
+  EXPECT_EQ(listener_b->bulk_ct, 1);
+  EXPECT_EQ(listener_b->bulk_task_ct, 2);
+
+  ::flush_task_list(list_a.get());
+  ::flush_task_list(list_b.get());
+  EXPECT_EQ(order, (std::vector<int>{0, 2, 1, 3}));
+}
+
 TEST(TaskList, runReturnsVoidPromise_noParams) {
   auto task_list = TaskList::Create();
 
@@ -257,3 +350,131 @@ TEST(TaskList, correctlyProfilesTasks) {
   EXPECT_TRUE(task_profile.Finished > task_profile.Started);
   EXPECT_EQ(task_profile.ExecutorThreadId, std::this_thread::get_id());
 }
+
+TEST(TaskList, noReadinessFdByDefault) {
+  auto task_list = TaskList::Create();
+  EXPECT_EQ(task_list->readiness_fd(), -1);
+}
+
+#if defined(__linux__)
+TEST(TaskList, readinessFdIsReadableUntilDrained) {
+  TaskList::Desc desc;
+  desc.UseReadinessFd = true;
+  auto task_list = TaskList::Create(desc);
+  int fd = task_list->readiness_fd();
+  ASSERT_GE(fd, 0);
+  EXPECT_FALSE(::is_readable(fd));
+
+  task_list->schedule(Task::Of(::noop));
+  EXPECT_TRUE(::is_readable(fd));
+
+  ::flush_task_list(task_list.get());
+  EXPECT_FALSE(::is_readable(fd));
+
+  task_list->schedule(Task::Of(::noop));
+  EXPECT_TRUE(::is_readable(fd));
+}
+
+TEST(TaskList, readinessFdCoalescesBursts) {
+  TaskList::Desc desc;
+  desc.UseReadinessFd = true;
+  auto task_list = TaskList::Create(desc);
+
+  for (int i = 0; i < 100; i++) {
+    task_list->schedule(Task::Of(::noop));
+  }
+  std::vector<std::unique_ptr<Task>> tasks;
+  tasks.push_back(Task::Of(::noop));
+  task_list->schedule_bulk(std::move(tasks));
+
+  uint64_t signal_count = 0;
+  ASSERT_EQ(::read(task_list->readiness_fd(), &signal_count,
+                   sizeof(signal_count)),
+            sizeof(signal_count));
+  EXPECT_EQ(signal_count, 1);
+}
+
+TEST(TaskList, readinessFdNeverMissesCrossThreadTasks) {
+  TaskList::Desc desc;
+  desc.UseReadinessFd = true;
+  auto task_list = TaskList::Create(desc);
+
+  const int kTaskCount = 20000;
+  int executed = 0;
+  std::thread producer([task_list, &executed]() {
+    for (int i = 0; i < kTaskCount; i++) {
+      task_list->schedule(Task::Of([&executed]() { executed++; }));
+      if (i % 64 == 0) std::this_thread::yield();
+    }
+  });
+
+  // A lost wakeup leaves tasks queued with the fd unreadable - that poll
+  // times out and fails the test
+  bool timed_out = false;
+  while (executed < kTaskCount) {
+    if (!::is_readable(task_list->readiness_fd(), 1000)) {
+      timed_out = true;
+      break;
+    }
+    ::flush_task_list(task_list.get());
+  }
+  producer.join();
+
+  EXPECT_FALSE(timed_out);
+  EXPECT_EQ(executed, kTaskCount);
+}
+
+TEST(TaskList, readinessFdDrainsLateSignals) {
+  TaskList::Desc desc;
+  desc.UseReadinessFd = true;
+  auto task_list = TaskList::Create(desc);
+  int fd = task_list->readiness_fd();
+
+  task_list->schedule(Task::Of(::noop));
+  ::flush_task_list(task_list.get());
+  ASSERT_FALSE(::is_readable(fd));
+
+  // Same state as a producer that set the flag, but only wrote to the
+  // eventfd after the consumer ran its task and reset the list
+  uint64_t one = 1;
+  ASSERT_EQ(::write(fd, &one, sizeof(one)), sizeof(one));
+
+  EXPECT_FALSE(task_list->execute_next());
+  EXPECT_FALSE(::is_readable(fd));
+}
+
+TEST(TaskList, readinessFdIsClearAfterRacingDrains) {
+  TaskList::Desc desc;
+  desc.UseReadinessFd = true;
+  auto task_list = TaskList::Create(desc);
+
+  const int kRounds = 200;
+  const int kProducerCount = 4;
+  const int kTasksPerProducer = 64;
+  for (int round = 0; round < kRounds; round++) {
+    std::atomic_int producers_done = 0;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducerCount; p++) {
+      producers.emplace_back([task_list, &producers_done]() {
+        for (int i = 0; i < kTasksPerProducer; i++) {
+          task_list->schedule(Task::Of(::noop));
+        }
+        producers_done++;
+      });
+    }
+
+    // Drain while producers are still signaling, so that some of their
+    // eventfd writes land after the reset that cleared the flag
+    while (producers_done < kProducerCount) {
+      ::flush_task_list(task_list.get());
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+
+    ::flush_task_list(task_list.get());
+    ASSERT_FALSE(::is_readable(task_list->readiness_fd()))
+        << "Readable over an empty list after round " << round;
+  }
+}
+#endif
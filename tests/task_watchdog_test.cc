@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <igasync/task_list.h>
+#include <igasync/task_watchdog.h>
+
+#include <string>
+#include <thread>
+
+using namespace igasync;
+
+namespace {
+TaskWatchdog::Desc fast_desc() {
+  TaskWatchdog::Desc desc;
+  desc.Threshold = std::chrono::milliseconds(5);
+  desc.PollInterval = std::chrono::milliseconds(1);
+  return desc;
+}
+}  // namespace
+
+TEST(TaskWatchdog, isOnlyWatchingWhileAlive) {
+  EXPECT_FALSE(TaskWatchdog::is_watching());
+  {
+    auto watchdog = TaskWatchdog::Create(::fast_desc());
+    EXPECT_TRUE(TaskWatchdog::is_watching());
+  }
+  EXPECT_FALSE(TaskWatchdog::is_watching());
+}
+
+TEST(TaskWatchdog, reportsSlowTaskOnce) {
+  TaskList::Desc tl_desc;
+  tl_desc.Name = "Slow list";
+  auto tl = TaskList::Create(tl_desc);
+
+  std::atomic_int callback_ct = 0;
+  std::string reported_name;
+  auto desc = ::fast_desc();
+  desc.OnStall = [&](const StalledTask& stall) {
+    callback_ct++;
+    reported_name = stall.Name ? stall.Name : "";
+  };
+  auto watchdog = TaskWatchdog::Create(desc);
+
+  tl->run(TaskLabel("sleepy"), []() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  });
+  while (tl->execute_next())
+    ;
+
+  watchdog = nullptr;
+
+  EXPECT_EQ(callback_ct, 1);
+  EXPECT_EQ(reported_name, "sleepy");
+}
+
+TEST(TaskWatchdog, recordsTaskListAndCallSite) {
+  TaskList::Desc tl_desc;
+  tl_desc.Name = "Slow list";
+  auto tl = TaskList::Create(tl_desc);
+
+  auto desc = ::fast_desc();
+  auto watchdog = TaskWatchdog::Create(desc);
+
+  tl->run(TaskLabel("sleepy"), []() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  });
+  while (tl->execute_next())
+    ;
+
+  auto stalls = watchdog->stalls();
+  ASSERT_EQ(stalls.size(), 1);
+  EXPECT_STREQ(stalls[0].Name, "sleepy");
+  EXPECT_EQ(stalls[0].TaskListName, "Slow list");
+  EXPECT_NE(std::string(stalls[0].File).find("task_watchdog_test"),
+            std::string::npos);
+  EXPECT_EQ(stalls[0].ThreadId, std::this_thread::get_id());
+  EXPECT_GE(stalls[0].RunningFor, desc.Threshold);
+}
+
+TEST(TaskWatchdog, reportsOuterTaskStalledAfterNestedTask) {
+  auto tl = TaskList::Create();
+  auto watchdog = TaskWatchdog::Create(::fast_desc());
+
+  tl->run(TaskLabel("outer"), [tl]() {
+    tl->run(TaskLabel("inner"), []() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    });
+    tl->execute_next();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  });
+  tl->execute_next();
+
+  auto stalls = watchdog->stalls();
+  ASSERT_EQ(stalls.size(), 2);
+  EXPECT_STREQ(stalls[0].Name, "inner");
+  EXPECT_STREQ(stalls[1].Name, "outer");
+}
+
+TEST(TaskWatchdog, ignoresFastTasks) {
+  auto tl = TaskList::Create();
+
+  TaskWatchdog::Desc desc;
+  desc.Threshold = std::chrono::seconds(10);
+  desc.PollInterval = std::chrono::milliseconds(1);
+  auto watchdog = TaskWatchdog::Create(desc);
+
+  for (int i = 0; i < 100; i++) {
+    tl->run([]() {});
+  }
+  while (tl->execute_next())
+    ;
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  EXPECT_EQ(watchdog->stalls().size(), 0);
+}
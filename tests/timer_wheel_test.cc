@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <igasync/task_list.h>
+#include <igasync/timer_wheel.h>
+
+#include <random>
+#include <thread>
+
+#include "test_objects.h"
+
+using namespace igasync;
+
+namespace {
+using Clock = TimerWheel::Clock;
+using std::chrono::milliseconds;
+
+TimerWheel::Desc pumped_desc() {
+  TimerWheel::Desc desc;
+  desc.UseDedicatedThread = false;
+  return desc;
+}
+}  // namespace
+
+TEST(TimerWheel, firesOnceDueAndNotBefore) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto t0 = Clock::now();
+
+  bool fired = false;
+  wheel->schedule_at(t0 + milliseconds(5),
+                     Task::Of([&fired]() { fired = true; }));
+  EXPECT_EQ(wheel->pending_count(), 1);
+
+  EXPECT_EQ(wheel->advance(t0 + milliseconds(4)), 0);
+  EXPECT_FALSE(fired);
+
+  EXPECT_EQ(wheel->advance(t0 + milliseconds(7)), 1);
+  EXPECT_TRUE(fired);
+  EXPECT_EQ(wheel->pending_count(), 0);
+}
+
+TEST(TimerWheel, scheduleInThePastFiresOnNextAdvance) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  wheel->advance(Clock::now() + milliseconds(50));
+
+  bool fired = false;
+  wheel->schedule_at(Clock::now() - milliseconds(10),
+                     Task::Of([&fired]() { fired = true; }));
+
+  EXPECT_EQ(wheel->advance(Clock::now()), 1);
+  EXPECT_TRUE(fired);
+}
+
+TEST(TimerWheel, dueTimersAreScheduledInBulk) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto ctx = std::make_shared<BulkCountingExecutionContext>();
+  auto t0 = Clock::now();
+
+  int fired = 0;
+  for (int i = 0; i < 3; i++) {
+    wheel->schedule_at(t0 + milliseconds(10),
+                       Task::Of([&fired]() { fired++; }), ctx);
+  }
+
+  EXPECT_EQ(wheel->advance(t0 + milliseconds(20)), 3);
+  EXPECT_EQ(fired, 3);
+  EXPECT_EQ(ctx->bulk_ct, 1);
+  EXPECT_EQ(ctx->schedule_ct, 0);
+}
+
+TEST(TimerWheel, cancelledTimersNeverFire) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto t0 = Clock::now();
+
+  bool fired = false;
+  auto id = wheel->schedule_at(t0 + milliseconds(5),
+                               Task::Of([&fired]() { fired = true; }));
+  EXPECT_TRUE(wheel->cancel(id));
+  EXPECT_FALSE(wheel->cancel(id));
+  EXPECT_EQ(wheel->pending_count(), 0);
+
+  EXPECT_EQ(wheel->advance(t0 + milliseconds(10)), 0);
+  EXPECT_FALSE(fired);
+}
+
+TEST(TimerWheel, staleIdsDoNotCancelReusedTimers) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto t0 = Clock::now();
+
+  auto fired_id = wheel->schedule_at(t0, Task::Of([]() {}));
+  wheel->advance(t0 + milliseconds(1));
+
+  // Takes over the storage of the fired timer
+  bool fired = false;
+  auto reused_id = wheel->schedule_at(t0 + milliseconds(5),
+                                      Task::Of([&fired]() { fired = true; }));
+  EXPECT_NE(fired_id, reused_id);
+  EXPECT_FALSE(wheel->cancel(fired_id));
+
+  wheel->advance(t0 + milliseconds(10));
+  EXPECT_TRUE(fired);
+}
+
+TEST(TimerWheel, farTimersCascadeToFinerLevels) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto t0 = Clock::now();
+
+  int fired = 0;
+  wheel->schedule_at(t0 + std::chrono::seconds(10),
+                     Task::Of([&fired]() { fired++; }));
+  wheel->schedule_at(t0 + std::chrono::hours(30),
+                     Task::Of([&fired]() { fired += 10; }));
+
+  auto wakeup = wheel->next_wakeup();
+  ASSERT_TRUE(wakeup.has_value());
+  EXPECT_LE(*wakeup, t0 + std::chrono::seconds(11));
+
+  EXPECT_EQ(wheel->advance(t0 + milliseconds(9990)), 0);
+  EXPECT_EQ(wheel->advance(t0 + milliseconds(10002)), 1);
+  EXPECT_EQ(fired, 1);
+
+  EXPECT_EQ(wheel->advance(t0 + std::chrono::hours(29)), 0);
+  EXPECT_EQ(wheel->advance(t0 + std::chrono::hours(31)), 1);
+  EXPECT_EQ(fired, 11);
+  EXPECT_FALSE(wheel->next_wakeup().has_value());
+}
+
+TEST(TimerWheel, randomTimersFireOnTheFirstAdvancePastTheirTime) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto t0 = Clock::now();
+  std::mt19937 rng(1234);
+
+  const int kTimerCount = 5000;
+  std::vector<Clock::time_point> due(kTimerCount);
+  std::vector<int> fire_ct(kTimerCount, 0);
+  std::vector<Clock::time_point> fired_at(kTimerCount);
+  std::vector<Clock::time_point> previous_at(kTimerCount);
+  Clock::time_point previous = t0;
+  Clock::time_point advanced_to = t0;
+
+  for (int i = 0; i < kTimerCount; i++) {
+    due[i] = t0 + milliseconds(
+                      std::uniform_int_distribution<int>(0, 300000)(rng));
+    wheel->schedule_at(due[i], Task::Of([&, i]() {
+                         fire_ct[i]++;
+                         fired_at[i] = advanced_to;
+                         previous_at[i] = previous;
+                       }));
+  }
+
+  while (wheel->pending_count() > 0) {
+    previous = advanced_to;
+    advanced_to +=
+        milliseconds(std::uniform_int_distribution<int>(1, 2000)(rng));
+    wheel->advance(advanced_to);
+  }
+
+  for (int i = 0; i < kTimerCount; i++) {
+    EXPECT_EQ(fire_ct[i], 1);
+    EXPECT_GE(fired_at[i], due[i]);
+    // Rounded up to a whole tick, so may wait out one more
+    EXPECT_LT(previous_at[i], due[i] + milliseconds(1));
+  }
+}
+
+TEST(TimerWheel, handlesManyPendingTimers) {
+  auto wheel = TimerWheel::Create(::pumped_desc());
+  auto t0 = Clock::now();
+
+  const int kTimerCount = 200000;
+  int fired = 0;
+  std::vector<TimerWheel::TimerId> ids;
+  ids.reserve(kTimerCount);
+  for (int i = 0; i < kTimerCount; i++) {
+    ids.push_back(wheel->schedule_at(t0 + milliseconds(i % 5000),
+                                     Task::Of([&fired]() { fired++; })));
+  }
+  EXPECT_EQ(wheel->pending_count(), kTimerCount);
+
+  for (int i = 0; i < kTimerCount; i += 2) {
+    EXPECT_TRUE(wheel->cancel(ids[i]));
+  }
+
+  wheel->advance(t0 + milliseconds(6000));
+  EXPECT_EQ(fired, kTimerCount / 2);
+  EXPECT_EQ(wheel->pending_count(), 0);
+}
+
+TEST(TimerWheel, timerThreadResolvesDelay) {
+  auto wheel = TimerWheel::Create();
+  auto tl = TaskList::Create();
+
+  auto start = Clock::now();
+  auto rsl = wheel->delay(milliseconds(5), tl);
+
+  while (!rsl->is_finished()) {
+    ASSERT_LT(Clock::now() - start, std::chrono::seconds(5));
+    tl->execute_next();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  EXPECT_GE(Clock::now() - start, milliseconds(5));
+}
+
+TEST(TimerWheel, timerThreadWakesForEarlierTimer) {
+  auto wheel = TimerWheel::Create();
+
+  std::atomic_bool fired = false;
+  wheel->schedule_after(std::chrono::hours(1), Task::Of([]() {}));
+  wheel->schedule_after(milliseconds(2),
+                        Task::Of([&fired]() { fired = true; }));
+
+  auto start = Clock::now();
+  while (!fired) {
+    ASSERT_LT(Clock::now() - start, std::chrono::seconds(5));
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  EXPECT_EQ(wheel->pending_count(), 1);
+}
+
+TEST(TimerWheel, delayUsesDefaultWheel) {
+  auto start = Clock::now();
+  auto rsl = igasync::delay(milliseconds(1));
+
+  while (!rsl->is_finished()) {
+    ASSERT_LT(Clock::now() - start, std::chrono::seconds(5));
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <igasync/task_list.h>
+#include <igasync/thread_pool.h>
+#include <igasync/trace_recorder.h>
+
+using namespace igasync;
+
+namespace {
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+
+size_t count_of(const std::string& haystack, const std::string& needle) {
+  size_t ct = 0;
+  for (size_t pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + needle.size())) {
+    ct++;
+  }
+  return ct;
+}
+}  // namespace
+
+TEST(TraceRecorder, recordsNothingWhenStopped) {
+  auto tl = TaskList::Create();
+  TraceRecorder::Get().start();
+  TraceRecorder::Get().stop();
+
+  tl->run([]() {});
+  ::flush_task_list(tl);
+
+  std::string json = TraceRecorder::Get().to_json();
+  EXPECT_EQ(::count_of(json, "\"ph\":\"X\""), 0);
+}
+
+TEST(TraceRecorder, recordsSliceNamedAfterTaskList) {
+  TaskList::Desc desc;
+  desc.Name = "Main thread";
+  auto tl = TaskList::Create(desc);
+  EXPECT_EQ(tl->name(), "Main thread");
+
+  TraceRecorder::Get().start();
+  tl->run([]() {});
+  tl->run([]() {});
+  ::flush_task_list(tl);
+  TraceRecorder::Get().stop();
+
+  std::string json = TraceRecorder::Get().to_json();
+  EXPECT_EQ(::count_of(json, "\"ph\":\"X\""), 2);
+  EXPECT_EQ(::count_of(json, "\"name\":\"Main thread\""), 2);
+  EXPECT_NE(json.find("queue_wait_us"), std::string::npos);
+}
+
+TEST(TraceRecorder, forgetsDestroyedTaskListNames) {
+  TaskList::Desc desc;
+  desc.Name = "Short lived";
+  auto tl = TaskList::Create(desc);
+
+  // The list restores the previous value once the task is done
+  uint32_t id = 0;
+  TraceRecorder::Get().start();
+  tl->run([&id]() { id = TraceRecorder::set_current_task_list(0); });
+  ::flush_task_list(tl);
+  TraceRecorder::Get().stop();
+  EXPECT_EQ(TraceRecorder::Get().task_list_name(id), "Short lived");
+
+  tl = nullptr;
+  EXPECT_EQ(TraceRecorder::Get().task_list_name(id), "");
+}
+
+TEST(TraceRecorder, keepsNamesOfTaskListsDestroyedWhileRecording) {
+  TaskList::Desc desc;
+  desc.Name = "Destroyed mid-trace";
+  auto tl = TaskList::Create(desc);
+
+  TraceRecorder::Get().start();
+  tl->run([]() {});
+  ::flush_task_list(tl);
+  tl = nullptr;
+  TraceRecorder::Get().stop();
+
+  std::string json = TraceRecorder::Get().to_json();
+  EXPECT_EQ(::count_of(json, "\"name\":\"Destroyed mid-trace\""), 1);
+
+  // Nothing recorded from before start() needs the name any more
+  TraceRecorder::Get().start();
+  TraceRecorder::Get().stop();
+  json = TraceRecorder::Get().to_json();
+  EXPECT_EQ(::count_of(json, "Destroyed mid-trace"), 0);
+}
+
+TEST(TraceRecorder, drawsFlowFromResolverToContinuation) {
+  auto tl = TaskList::Create();
+
+  TraceRecorder::Get().start();
+  auto p = Promise<int>::Create();
+  p->on_resolve([](const int&) {}, tl);
+  tl->run([p]() { p->resolve(5); });
+  ::flush_task_list(tl);
+  TraceRecorder::Get().stop();
+
+  std::string json = TraceRecorder::Get().to_json();
+  EXPECT_EQ(::count_of(json, "\"ph\":\"X\""), 2);
+  EXPECT_EQ(::count_of(json, "\"ph\":\"s\""), 1);
+  EXPECT_EQ(::count_of(json, "\"ph\":\"f\""), 1);
+}
+
+TEST(TraceRecorder, keepsOnlyMostRecentEventsPerThread) {
+  auto tl = TaskList::Create();
+
+  TraceRecorder::Get().start(4);
+  for (int i = 0; i < 10; i++) {
+    tl->run([]() {});
+  }
+  ::flush_task_list(tl);
+  TraceRecorder::Get().stop();
+
+  std::string json = TraceRecorder::Get().to_json();
+  EXPECT_EQ(::count_of(json, "\"ph\":\"X\""), 4);
+}
+
+TEST(TraceRecorder, namesThreadPoolWorkers) {
+  auto tl = TaskList::Create();
+  ThreadPool::Desc desc{};
+  desc.UseHardwareConcurrency = false;
+  desc.AdditionalThreads = 2;
+  auto pool = ThreadPool::Create(desc);
+  pool->add_task_list(tl);
+
+  TraceRecorder::Get().start();
+  std::vector<std::shared_ptr<Promise<void>>> promises;
+  for (int i = 0; i < 20; i++) {
+    promises.push_back(tl->run([]() {}));
+  }
+  for (auto& p : promises) {
+    while (!p->is_finished()) {
+      std::this_thread::yield();
+    }
+  }
+  TraceRecorder::Get().stop();
+
+  // Slices are written just after the task (and so its promise) finishes
+  std::string json = TraceRecorder::Get().to_json();
+  for (int i = 0; i < 1000 && ::count_of(json, "\"ph\":\"X\"") < 20; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    json = TraceRecorder::Get().to_json();
+  }
+
+  EXPECT_NE(json.find("igasync worker 0"), std::string::npos);
+  EXPECT_EQ(::count_of(json, "\"ph\":\"X\""), 20);
+}
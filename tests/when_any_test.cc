@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <igasync/task_list.h>
+#include <igasync/when_any.h>
+
+using namespace igasync;
+
+namespace {
+class CountingExecutionContext : public ExecutionContext {
+ public:
+  CountingExecutionContext(std::shared_ptr<TaskList> inner)
+      : inner_(inner), schedule_ct(0) {}
+
+  virtual void schedule(std::unique_ptr<Task> task) override {
+    schedule_ct++;
+    inner_->schedule(std::move(task));
+  }
+
+  std::shared_ptr<TaskList> inner_;
+  int schedule_ct;
+};
+
+void flush_task_list(std::shared_ptr<TaskList> tl) {
+  while (tl->execute_next())
+    ;
+}
+}  // namespace
+
+TEST(WhenAny, resolvesWithFirstPromise) {
+  auto tl = TaskList::Create();
+
+  auto p1 = Promise<int>::Create();
+  auto p2 = Promise<int>::Create();
+  auto p3 = Promise<int>::Create();
+
+  auto rsl = when_any<int>({p1, p2, p3}, tl);
+  ::flush_task_list(tl);
+  EXPECT_FALSE(rsl->is_finished());
+
+  p2->resolve(20);
+  ::flush_task_list(tl);
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek().Index, 1);
+  EXPECT_EQ(rsl->unsafe_sync_peek().Value, 20);
+
+  p1->resolve(10);
+  p3->resolve(30);
+  ::flush_task_list(tl);
+  EXPECT_EQ(rsl->unsafe_sync_peek().Index, 1);
+  EXPECT_EQ(rsl->unsafe_sync_peek().Value, 20);
+}
+
+TEST(WhenAny, alreadyResolvedPromiseWins) {
+  auto tl = TaskList::Create();
+
+  auto p1 = Promise<int>::Create();
+  auto p2 = Promise<int>::Immediate(5);
+
+  auto rsl = when_any<int>({p1, p2}, tl);
+  ::flush_task_list(tl);
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek().Index, 1);
+  EXPECT_EQ(rsl->unsafe_sync_peek().Value, 5);
+}
+
+TEST(WhenAny, losersAreNeverScheduled) {
+  auto tl = TaskList::Create();
+  auto ctx = std::make_shared<::CountingExecutionContext>(tl);
+
+  auto p1 = Promise<int>::Create();
+  auto p2 = Promise<int>::Create();
+  auto p3 = Promise<int>::Create();
+
+  auto rsl = when_any<int>({p1, p2, p3}, ctx);
+
+  p3->resolve(3);
+  p1->resolve(1);
+  p2->resolve(2);
+  ::flush_task_list(tl);
+
+  EXPECT_EQ(ctx->schedule_ct, 1);
+  EXPECT_EQ(rsl->unsafe_sync_peek().Index, 2);
+}
+
+TEST(WhenAny, invokesOnLostForEachLoser) {
+  auto tl = TaskList::Create();
+
+  auto p1 = Promise<int>::Create();
+  auto p2 = Promise<int>::Create();
+  auto p3 = Promise<int>::Create();
+
+  std::vector<size_t> lost;
+  auto rsl = when_any<int>({p1, p2, p3}, tl,
+                           [&lost](size_t idx) { lost.push_back(idx); });
+
+  p1->resolve(1);
+  ::flush_task_list(tl);
+
+  ASSERT_EQ(lost.size(), 2);
+  EXPECT_EQ(lost[0], 1);
+  EXPECT_EQ(lost[1], 2);
+}
+
+TEST(WhenAny, unresolvedLosersDoNotRetainResultOrOnLost) {
+  auto tl = TaskList::Create();
+
+  auto p1 = Promise<int>::Create();
+  auto p2 = Promise<int>::Create();
+
+  auto marker = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_marker = marker;
+  auto rsl = when_any<int>({p1, p2}, tl, [marker](size_t) {});
+  std::weak_ptr<Promise<WhenAnyResult<int>>> weak_rsl = rsl;
+  marker = nullptr;
+
+  p1->resolve(1);
+  ::flush_task_list(tl);
+  EXPECT_EQ(rsl->unsafe_sync_peek().Index, 0);
+  rsl = nullptr;
+
+  // p2 never resolves, and still holds its when_any continuation
+  EXPECT_TRUE(weak_marker.expired());
+  EXPECT_TRUE(weak_rsl.expired());
+}
+
+TEST(WhenAny, losingPromiseCanStillBeConsumed) {
+  auto tl = TaskList::Create();
+
+  auto p1 = Promise<int>::Create();
+  auto p2 = Promise<int>::Create();
+
+  auto rsl = when_any<int>({p1, p2}, tl);
+
+  int consumed = 0;
+  p2->consume([&consumed](int v) { consumed = v; }, tl);
+
+  p1->resolve(1);
+  p2->resolve(2);
+  ::flush_task_list(tl);
+
+  EXPECT_EQ(rsl->unsafe_sync_peek().Index, 0);
+  EXPECT_EQ(consumed, 2);
+}
+
+TEST(WhenAny, racesVoidPromises) {
+  auto tl = TaskList::Create();
+
+  auto p1 = Promise<void>::Create();
+  auto p2 = Promise<void>::Create();
+
+  auto rsl = when_any({p1, p2}, tl);
+  ::flush_task_list(tl);
+  EXPECT_FALSE(rsl->is_finished());
+
+  p2->resolve();
+  p1->resolve();
+  ::flush_task_list(tl);
+
+  ASSERT_TRUE(rsl->is_finished());
+  EXPECT_EQ(rsl->unsafe_sync_peek(), 1);
+}